@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+    BandAligner.h
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BufferArena.h"
+#include "Params.h"
+
+/**
+ Delays every band up to the latency of the slowest one, so bands that went through
+ resamplers (MultirateLowBand, OversampledCompressor) or a look-ahead still sum back
+ to a flat response. Bands that need no delay are not touched.
+ The rings hold SampleType, the precision the bands are processed at, one per band and
+ prepared channel.
+ */
+template<size_t NumBands, typename SampleType = float>
+struct BandAligner
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+
+    static size_t getArenaSize(int maxDelay, size_t numChannels) { return NumBands * numChannels * BufferArena::getSliceSize<SampleType>(getRingSize(maxDelay)); }
+
+    //maxDelay is the largest band latency that can come up before the next prepare()
+    void prepare(BufferArena& arena, int maxDelay, size_t numChannels)
+    {
+        jassert( numChannels <= MaxChannels );
+
+        ringSize = getRingSize(maxDelay);
+        mask = ringSize - 1;
+        this->maxDelay = maxDelay;
+        numPreparedChannels = numChannels;
+
+        rings = {};
+        for ( auto& band : rings )
+        {
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+                band[ch] = arena.allocate<SampleType>(ringSize);
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        for ( size_t band = 0; band < NumBands; ++band )
+            clearBand(band);
+
+        position = 0;
+    }
+
+    //forgets the rings, e.g. when the arena is released or the other precision is prepared
+    void release()
+    {
+        rings = {};
+        ringSize = 0;
+        mask = 0;
+        position = 0;
+        numPreparedChannels = 0;
+    }
+
+    //delays[band] becomes the largest latency minus the band's own one
+    void setBandLatencies(const std::array<int, NumBands>& latencies)
+    {
+        //an aligner without rings (not prepared, or released) only keeps the delays
+        latency = *std::max_element(latencies.begin(), latencies.end());
+        jassert( ringSize == 0 || latency <= maxDelay );
+
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            auto delay = static_cast<size_t>(latency - latencies[band]);
+            if ( delay != delays[band] )
+            {
+                //a stale ring would replay old audio at the new delay
+                delays[band] = delay;
+                clearBand(band);
+            }
+        }
+    }
+
+    int getLatencySamples() const { return latency; }
+
+    void process(const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+    {
+        auto numChannels = juce::jmin(bands[0].getNumChannels(), numPreparedChannels);
+        auto numSamples = bands[0].getNumSamples();
+
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            auto delay = delays[band];
+            if ( delay == 0 )
+                continue;
+
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+            {
+                auto* ring = rings[band][ch];
+                auto* data = bands[band].getChannelPointer(ch);
+
+                for ( size_t i = 0; i < numSamples; ++i )
+                {
+                    auto write = (position + i) & mask;
+                    ring[write] = data[i];
+                    data[i] = ring[(write - delay) & mask];
+                }
+            }
+        }
+
+        position = (position + numSamples) & mask;
+    }
+private:
+    //a power of two, the ring index is masked
+    static size_t getRingSize(int maxDelay) { return static_cast<size_t>(juce::nextPowerOfTwo(maxDelay + 1)); }
+
+    void clearBand(size_t band)
+    {
+        for ( auto* ring : rings[band] )
+        {
+            if ( ring != nullptr )
+                std::fill(ring, ring + ringSize, SampleType(0));
+        }
+    }
+
+    std::array<std::array<SampleType*, MaxChannels>, NumBands> rings {};
+    std::array<size_t, NumBands> delays {};
+    size_t ringSize = 0;
+    size_t mask = 0;
+    size_t position = 0;
+    size_t numPreparedChannels = 0;
+    int maxDelay = 0;
+    int latency = 0;
+};
@@ -0,0 +1,16 @@
+/*
+  ==============================================================================
+
+    BatchProcessor.cpp
+    Created: 18 Oct 2026 10:41:52am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "BatchProcessor.h"
+
+//the lane counts of SSE/NEON, AVX2 and AVX-512 builds, compiled with the plugin so none of them can rot
+template struct BatchProcessor<4>;
+template struct BatchProcessor<8>;
+template struct BatchProcessor<16>;
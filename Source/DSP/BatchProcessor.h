@@ -0,0 +1,309 @@
+/*
+  ==============================================================================
+
+    BatchProcessor.h
+    Created: 17 Oct 2026 1:46:08pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParamSnapshot.h"
+#include "Crossover.h"
+#include "DynamicsKernel.h"
+#include "Params.h"
+
+/**
+ Everything one SkwiezorMB chain needs to know, i.e. the plugin's parameters
+ (the ratio as a value, not a choice index). Defaults match the plugin's parameter defaults.
+ */
+template<size_t NumBands>
+struct StreamSettings
+{
+    StreamSettings()
+    {
+        crossover.cutoffs = Params::GetDefaultCrossoverFrequencies<NumBands>();
+        bands.fill(CompressorSettings { 50.f, 250.f, 0.f, 3.f, false });
+    }
+
+    GainSettings gain;
+    CrossoverSettings<NumBands> crossover;
+    std::array<CompressorSettings, NumBands> bands;
+
+    std::array<bool, NumBands> mute {};
+    std::array<bool, NumBands> solo {};
+};
+
+/**
+ Runs many identical SkwiezorMB chains (input gain -> crossover -> compressors -> band sum
+ -> output gain) at once, one independent stream per lane. Every stage updates all lanes
+ with one loop, so NumLanes streams cost about as much as a single one in scalar code.
+
+ A stream is one mono signal with its own settings. A stereo stem is two streams with the
+ same settings, which is what the plugin does with Channel Link off: streams are never linked,
+ each one only detects its own samples.
+
+ NumLanes should match the registers of the build: 4 for SSE/NEON, 8 for AVX2, 16 for AVX-512.
+ NumBands can differ from the plugin build, e.g. 2 bands for stems that only need low/high control.
+ */
+template<size_t NumLanes, size_t NumBands = Params::NumBands>
+struct BatchProcessor
+{
+    using Frame = std::array<float, NumLanes>;
+    using Settings = StreamSettings<NumBands>;
+
+    void prepare(double newSampleRate)
+    {
+        jassert( newSampleRate > 0 );
+
+        sampleRate = newSampleRate;
+        numRampSamples = static_cast<int>(std::floor(rampDurationSeconds * sampleRate));
+        crossoverTable = CrossoverCoefficientTable::getShared(sampleRate);
+
+        //everything depends on the sample rate, so every lane is set up again
+        for ( size_t stream = 0; stream < NumLanes; ++stream )
+        {
+            auto& snapshots = streamSnapshots[stream];
+            snapshots.crossover.invalidate();
+            snapshots.gain.invalidate();
+            for ( auto& band : snapshots.bands )
+                band.invalidate();
+
+            setStreamSettings(stream, streamSettings[stream]);
+        }
+
+        reset();
+    }
+
+    void reset()
+    {
+        crossover.reset();
+        for ( auto& compressor : compressors )
+            compressor.reset();
+
+        inputGain.skipRamps();
+        outputGain.skipRamps();
+    }
+
+    //only the parts that changed since the last call are recalculated, gain changes are ramped like in the plugin
+    void setStreamSettings(size_t stream, const Settings& settings)
+    {
+        jassert( stream < NumLanes );
+
+        streamSettings[stream] = settings;
+        auto& snapshots = streamSnapshots[stream];
+
+        //before prepare() the cutoffs are only stored, prepare() sets every stream again
+        if ( crossoverTable != nullptr && snapshots.crossover.update(settings.crossover) )
+        {
+            crossover.setCutoffFrequencies(stream, settings.crossover.cutoffs, *crossoverTable);
+        }
+
+        auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / sampleRate;
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            if ( snapshots.bands[band].update(settings.bands[band]) )
+                compressors[band].setLane(stream, settings.bands[band], expFactor);
+        }
+
+        if ( snapshots.gain.update(settings.gain) )
+        {
+            inputGain.setTarget(stream, juce::Decibels::decibelsToGain(settings.gain.inputGainDb), numRampSamples);
+            outputGain.setTarget(stream, juce::Decibels::decibelsToGain(settings.gain.outputGainDb), numRampSamples);
+        }
+
+        auto bandsAreSoloed = std::find(settings.solo.begin(), settings.solo.end(), true) != settings.solo.end();
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            auto audible = bandsAreSoloed ? settings.solo[band] && !settings.mute[band] : !settings.mute[band];
+            bandMask[band][stream] = audible ? 1.f : 0.f;
+        }
+    }
+
+    const Settings& getStreamSettings(size_t stream) const
+    {
+        jassert( stream < NumLanes );
+        return streamSettings[stream];
+    }
+
+    //the slopes decide which sections run, so unlike the other settings they are shared by all streams
+    void setCrossoverSlopes(const typename CrossoverKernel<NumLanes, NumBands>::Slopes& slopes)
+    {
+        crossover.setSlopes(slopes);
+    }
+
+    //processes streams[0 .. numStreams) in place, every stream holds numSamples samples
+    void process(float* const* streams, size_t numStreams, size_t numSamples)
+    {
+        jassert( numStreams <= NumLanes );
+
+        //local copies let the compiler keep the lane state out of reach of the stream pointers
+        auto crossoverState = crossover;
+        auto compressorState = compressors;
+        auto inputGainState = inputGain;
+        auto outputGainState = outputGain;
+        const auto mask = bandMask;
+
+        //lanes without a stream run on silence
+        alignas(Alignment) Frame frame {};
+        alignas(Alignment) std::array<Frame, NumBands> bands;
+        alignas(Alignment) Frame level;
+        alignas(Alignment) Frame gain;
+
+        size_t start = 0;
+        while ( start < numSamples )
+        {
+            //gains ramp with a constant step until the next lane reaches its target
+            auto length = juce::jmin(numSamples - start,
+                                     inputGainState.getSamplesToNextTarget(),
+                                     outputGainState.getSamplesToNextTarget());
+
+            for ( size_t i = start; i < start + length; ++i )
+            {
+                for ( size_t stream = 0; stream < numStreams; ++stream )
+                    frame[stream] = streams[stream][i];
+
+                inputGainState.apply(frame);
+
+                crossoverState.processFrame(frame, bands);
+
+                //every stream detects its own samples, the batch has no meters for gain
+                for ( size_t band = 0; band < NumBands; ++band )
+                {
+                    for ( size_t lane = 0; lane < NumLanes; ++lane )
+                        level[lane] = std::abs(bands[band][lane]);
+
+                    compressorState[band].processFrame(bands[band], level, gain);
+                }
+
+                for ( size_t lane = 0; lane < NumLanes; ++lane )
+                    frame[lane] = bands[0][lane] * mask[0][lane];
+
+                for ( size_t band = 1; band < NumBands; ++band )
+                {
+                    for ( size_t lane = 0; lane < NumLanes; ++lane )
+                        frame[lane] += bands[band][lane] * mask[band][lane];
+                }
+
+                outputGainState.apply(frame);
+
+                for ( size_t stream = 0; stream < numStreams; ++stream )
+                    streams[stream][i] = frame[stream];
+            }
+
+            inputGainState.advance(length);
+            outputGainState.advance(length);
+            start += length;
+        }
+
+        crossoverState.snapToZero();
+
+        crossover = crossoverState;
+        compressors = compressorState;
+        inputGain = inputGainState;
+        outputGain = outputGainState;
+    }
+private:
+    static constexpr size_t Alignment = NumLanes * sizeof(float);
+
+    /**
+     Per lane linear gain ramps, the same as juce::dsp::Gain with a linear SmoothedValue:
+     the gain moves by a constant step every sample and lands exactly on the target.
+     */
+    struct GainLanes
+    {
+        void setTarget(size_t lane, float newTarget, int numSteps)
+        {
+            target[lane] = newTarget;
+
+            if ( numSteps <= 0 )
+            {
+                skipRamp(lane);
+                return;
+            }
+
+            step[lane] = (target[lane] - current[lane]) / static_cast<float>(numSteps);
+            remaining[lane] = static_cast<size_t>(numSteps);
+        }
+
+        void skipRamps()
+        {
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+                skipRamp(lane);
+        }
+
+        size_t getSamplesToNextTarget() const
+        {
+            auto samples = std::numeric_limits<size_t>::max();
+            for ( auto r : remaining )
+            {
+                if ( r > 0 )
+                    samples = juce::jmin(samples, r);
+            }
+
+            return samples;
+        }
+
+        forcedinline void apply(Frame& frame)
+        {
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+            {
+                current[lane] += step[lane];
+                frame[lane] *= current[lane];
+            }
+        }
+
+        //call after apply() ran numSamples (<= getSamplesToNextTarget()) times
+        void advance(size_t numSamples)
+        {
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+            {
+                if ( remaining[lane] == 0 )
+                    continue;
+
+                jassert( numSamples <= remaining[lane] );
+                remaining[lane] -= numSamples;
+
+                if ( remaining[lane] == 0 )
+                    skipRamp(lane);
+            }
+        }
+    private:
+        void skipRamp(size_t lane)
+        {
+            current[lane] = target[lane];
+            step[lane] = 0.f;
+            remaining[lane] = 0;
+        }
+
+        alignas(Alignment) Frame current {};
+        alignas(Alignment) Frame target {};
+        alignas(Alignment) Frame step {};
+        std::array<size_t, NumLanes> remaining {};
+    };
+
+    struct Snapshots
+    {
+        ParamSnapshot<GainSettings> gain;
+        ParamSnapshot<CrossoverSettings<NumBands>> crossover;
+        std::array<ParamSnapshot<CompressorSettings>, NumBands> bands;
+    };
+
+    CrossoverKernel<NumLanes, NumBands> crossover;
+    std::array<CompressorLanes<NumLanes>, NumBands> compressors;
+    GainLanes inputGain, outputGain;
+
+    //1 for audible bands, 0 for muted or not soloed ones
+    alignas(Alignment) std::array<Frame, NumBands> bandMask {};
+
+    std::array<Settings, NumLanes> streamSettings;
+    std::array<Snapshots, NumLanes> streamSnapshots;
+
+    double sampleRate = 44100.0;
+    std::shared_ptr<const CrossoverCoefficientTable> crossoverTable;
+    static constexpr double rampDurationSeconds = 0.05;
+    int numRampSamples = 0;
+};
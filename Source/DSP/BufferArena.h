@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    BufferArena.h
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <new>
+
+/**
+ One block of raw storage that the band buffers and the resamplers carve their buffers out of,
+ sized and handed out in floats.
+
+ reserve() is the only call that allocates and belongs in prepareToPlay(), with the total
+ of everything that will be carved out (every prepare() that takes an arena has a matching
+ static getArenaSize(), which counts each slice with getSliceSize()). allocate() then just
+ hands out consecutive, zeroed slices.
+
+ The storage is plain bytes, and allocate<T>() creates the slice's T objects in it with
+ placement new, so float and double slices are real arrays of their type and never alias.
+
+ Every slice starts on a cache line and is padded to whole lines, so vector loads from
+ the start of a slice are aligned and no two slices (or instances) share a line.
+ */
+struct BufferArena
+{
+    static constexpr size_t Alignment = 64;
+    static constexpr size_t FloatsPerLine = Alignment / sizeof(float);
+
+    //what allocate<T>(count) takes out of the arena, in floats
+    template<typename T = float>
+    static constexpr size_t getSliceSize(size_t count)
+    {
+        static_assert( sizeof(T) % sizeof(float) == 0 && Alignment % alignof(T) == 0, "a slice holds whole floats" );
+        static_assert( std::is_trivially_destructible<T>::value, "slices are never destroyed, only dropped" );
+
+        auto numFloats = count * (sizeof(T) / sizeof(float));
+        return (numFloats + FloatsPerLine - 1) / FloatsPerLine * FloatsPerLine;
+    }
+
+    //drops all slices handed out so far
+    void reserve(size_t numFloats)
+    {
+        //one line extra, the first slice starts at the first line boundary of the storage
+        storage.assign((numFloats + FloatsPerLine) * sizeof(float), std::byte {});
+
+        auto address = reinterpret_cast<std::uintptr_t>(storage.data());
+        base = storage.data() + (Alignment - address % Alignment) % Alignment;
+        capacity = numFloats;
+        used = 0;
+    }
+
+    //count samples of T, e.g. the double band buffers of the double precision path
+    template<typename T = float>
+    T* allocate(size_t count)
+    {
+        auto sliceSize = getSliceSize<T>(count);
+        jassert( used + sliceSize <= capacity );
+
+        auto* slice = base + used * sizeof(float);
+        used += sliceSize;
+
+        //value-initialised, i.e. zero, and the lifetime of each T starts here
+        for ( size_t i = 0; i < count; ++i )
+            ::new (static_cast<void*>(slice + i * sizeof(T))) T();
+
+        return std::launder(reinterpret_cast<T*>(slice));
+    }
+
+    //frees the storage, every slice handed out dangles until the next reserve()
+    void release()
+    {
+        std::vector<std::byte>().swap(storage);
+        base = nullptr;
+        capacity = 0;
+        used = 0;
+    }
+
+    size_t getNumReserved() const { return capacity; }
+    size_t getNumUsed() const { return used; }
+private:
+    std::vector<std::byte> storage;
+    std::byte* base = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+};
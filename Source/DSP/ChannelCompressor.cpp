@@ -0,0 +1,293 @@
+/*
+  ==============================================================================
+
+    ChannelCompressor.cpp
+    Created: 17 Oct 2026 10:21:37pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "ChannelCompressor.h"
+
+size_t ChannelCompressor::Detectors::getArenaSize(size_t numChannels, size_t maxSamples)
+{
+    //as many linked groups as the channels can form
+    return numChannels / 2 * BufferArena::getSliceSize(maxSamples);
+}
+
+void ChannelCompressor::Detectors::prepare(BufferArena& arena, size_t numChannels, size_t newMaxSamples)
+{
+    maxSamples = newMaxSamples;
+    buffers = {};
+    for ( size_t group = 0; group < numChannels / 2; ++group )
+        buffers[group] = arena.allocate(maxSamples);
+}
+
+void ChannelCompressor::prepare(size_t numChannels, int maxWindowSamples, const Detectors& detectors)
+{
+    jassert( numChannels <= MaxChannels );
+
+    numPreparedChannels = numChannels;
+
+    //the pairs a layout does not reach hold no look-ahead lines
+    for ( size_t p = 0; p < MaxPairs; ++p )
+    {
+        if ( p * NumLanes < numChannels )
+            pairs[p].lookAhead.prepare(maxWindowSamples);
+        else
+            pairs[p].lookAhead.release();
+    }
+
+    //the arena slices are only pointed to, whoever prepared them may hand them to other compressors too
+    linkedDetectors = detectors;
+
+    links.setGroups(linkGroups, numPreparedChannels);
+
+    reset();
+}
+
+void ChannelCompressor::reset()
+{
+    for ( auto& pair : pairs )
+    {
+        pair.compressor.reset();
+        pair.lookAhead.reset();
+        pair.meters.reset();
+    }
+}
+
+void ChannelCompressor::release()
+{
+    for ( auto& pair : pairs )
+        pair.lookAhead.release();
+}
+
+size_t ChannelCompressor::getAllocatedBytes() const
+{
+    size_t numBytes = 0;
+    for ( const auto& pair : pairs )
+        numBytes += pair.lookAhead.getAllocatedBytes();
+
+    return numBytes;
+}
+
+void ChannelCompressor::setSettings(const CompressorSettings& settings, double expFactor, int windowSamples)
+{
+    for ( auto& pair : pairs )
+    {
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+        {
+            pair.compressor.setLane(lane, settings, expFactor);
+            pair.lookAhead.setWindow(lane, windowSamples);
+        }
+    }
+}
+
+void ChannelCompressor::setLinkGroups(const ChannelLinks::Groups& groups)
+{
+    linkGroups = groups;
+    links.setGroups(linkGroups, numPreparedChannels);
+}
+
+void ChannelCompressor::setLinkSettings(const LinkSettings& settings)
+{
+    links.setSettings(settings);
+}
+
+void ChannelCompressor::computeDetectors(const float* const* channels, size_t numChannels, size_t numSamples, std::array<const float*, MaxChannels>& detectors)
+{
+    if ( ! links.isLinked() )
+        return;
+
+    jassert( numSamples <= linkedDetectors.maxSamples );
+
+    for ( size_t group = 0; group < links.getNumGroups(); ++group )
+        links.computeDetector(group, channels, numSamples, linkedDetectors.buffers[group]);
+
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto group = links.getGroup(ch);
+        if ( group >= 0 )
+            detectors[ch] = linkedDetectors.buffers[static_cast<size_t>(group)];
+    }
+}
+
+void ChannelCompressor::process(float* const* channels, size_t numChannels, size_t numSamples)
+{
+    numChannels = juce::jmin(numChannels, numPreparedChannels);
+
+    std::array<const float*, MaxChannels> detectors {};
+    computeDetectors(channels, numChannels, numSamples, detectors);
+
+    for ( size_t first = 0; first < numChannels; first += NumLanes )
+        processPair(pairs[first / NumLanes], channels + first, detectors.data() + first, juce::jmin(NumLanes, numChannels - first), numSamples);
+}
+
+void ChannelCompressor::processPair(Pair& pair, float* const* channels, const float* const* detectors, size_t numChannels, size_t numSamples)
+{
+    using Frame = CompressorLanes<NumLanes>::Frame;
+
+    //a local copy lets the compiler keep the envelopes in registers
+    auto state = pair.compressor;
+    alignas(NumLanes * sizeof(float)) Frame frame {};
+    alignas(NumLanes * sizeof(float)) Frame level {};
+    alignas(NumLanes * sizeof(float)) Frame input {};
+    alignas(NumLanes * sizeof(float)) Frame gain {};
+    auto levelMeters = pair.meters;
+    auto& lookAhead = pair.lookAhead;
+    auto lookingAhead = lookAhead.isActive();
+
+    static constexpr std::array<size_t, NumLanes> lanes { 0, 1 };
+
+    auto fullyLinked = links.isFullyLinked();
+    auto linkAmount = links.getAmount();
+
+    for ( size_t start = 0; start < numSamples; start += DynamicsKernel::QuietSegmentLength )
+    {
+        auto end = juce::jmin(start + DynamicsKernel::QuietSegmentLength, numSamples);
+
+        //the fast path of DynamicsKernel: while the gain cannot leave unity only the envelopes run
+        alignas(NumLanes * sizeof(float)) Frame peak {};
+        for ( size_t ch = 0; ch < numChannels; ++ch )
+        {
+            peak[ch] = lookAhead.getWindowPeak(ch);
+
+            //a linked detector is |sample| already, a partly linked level lies between it and the channel's own
+            if ( detectors[ch] != nullptr )
+            {
+                for ( size_t i = start; i < end; ++i )
+                    peak[ch] = FastMath::maxNonNegative(peak[ch], detectors[ch][i]);
+            }
+
+            if ( detectors[ch] == nullptr || ! fullyLinked )
+            {
+                for ( size_t i = start; i < end; ++i )
+                    peak[ch] = FastMath::maxNonNegative(peak[ch], std::abs(channels[ch][i]));
+            }
+        }
+
+        auto quiet = state.staysAtUnity(peak, lanes.data(), numChannels, false);
+        if ( quiet )
+            gain.fill(1.f);
+
+        for ( size_t i = start; i < end; ++i )
+        {
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+                frame[ch] = channels[ch][i];
+
+            input = frame;
+
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+                level[lane] = std::abs(frame[lane]);
+
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+            {
+                if ( detectors[ch] != nullptr )
+                    level[ch] = fullyLinked ? detectors[ch][i] : ChannelLinks::getLinkedLevel(level[ch], detectors[ch][i], linkAmount);
+            }
+
+            if ( lookingAhead )
+                lookAhead.processFrame(frame, level);
+
+            if ( quiet )
+                state.updateDetectors(level);
+            else
+                state.processFrame(frame, level, gain);
+
+            levelMeters.add(input, frame, gain);
+
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+                channels[ch][i] = frame[ch];
+        }
+    }
+
+    levelMeters.endBlock(numSamples);
+    pair.compressor = state;
+    pair.meters = levelMeters;
+}
+
+void ChannelCompressor::processDetector(const float* const* channels, size_t numChannels, size_t numSamples,
+                                        size_t repeats, size_t interval, size_t phase)
+{
+    using Frame = CompressorLanes<NumLanes>::Frame;
+
+    jassert( interval > 0 );
+    numChannels = juce::jmin(numChannels, numPreparedChannels);
+
+    std::array<const float*, MaxChannels> detectors {};
+    computeDetectors(channels, numChannels, numSamples, detectors);
+
+    auto fullyLinked = links.isFullyLinked();
+    auto linkAmount = links.getAmount();
+
+    for ( size_t first = 0; first < numChannels; first += NumLanes )
+    {
+        auto& pair = pairs[first / NumLanes];
+        auto numPairChannels = juce::jmin(NumLanes, numChannels - first);
+
+        auto state = pair.compressor;
+        alignas(NumLanes * sizeof(float)) Frame input {};
+        alignas(NumLanes * sizeof(float)) Frame frame {};
+        alignas(NumLanes * sizeof(float)) Frame level {};
+        auto levelMeters = pair.meters;
+        auto& lookAhead = pair.lookAhead;
+        auto lookingAhead = lookAhead.isActive();
+
+        for ( size_t i = 0; i < numSamples; ++i )
+        {
+            for ( size_t ch = 0; ch < numPairChannels; ++ch )
+                input[ch] = channels[first + ch][i];
+
+            levelMeters.addInput(input);
+
+            if ( (phase + i) % interval != 0 )
+                continue;
+
+            for ( size_t k = 0; k < repeats; ++k )
+            {
+                frame = input;
+
+                for ( size_t lane = 0; lane < NumLanes; ++lane )
+                    level[lane] = std::abs(frame[lane]);
+
+                for ( size_t ch = 0; ch < numPairChannels; ++ch )
+                {
+                    if ( const auto* detector = detectors[first + ch] )
+                        level[ch] = fullyLinked ? detector[i] : ChannelLinks::getLinkedLevel(level[ch], detector[i], linkAmount);
+                }
+
+                if ( lookingAhead )
+                    lookAhead.processFrame(frame, level);
+
+                state.updateDetectors(level);
+            }
+        }
+
+        levelMeters.endBlock(numSamples);
+        pair.compressor = state;
+        pair.meters = levelMeters;
+    }
+}
+
+BandLevels ChannelCompressor::getLevels() const
+{
+    static constexpr std::array<size_t, NumLanes> lanes { 0, 1 };
+
+    //the pairs as one meter, their RMS levels count by their channels
+    BandLevels levels;
+    for ( size_t first = 0; first < numPreparedChannels; first += NumLanes )
+    {
+        auto numPairChannels = juce::jmin(NumLanes, numPreparedChannels - first);
+        auto pairLevels = pairs[first / NumLanes].meters.getLevels(lanes.data(), numPairChannels);
+        levels = mergeBandLevels(levels, first, pairLevels, numPairChannels);
+    }
+
+    return levels;
+}
+
+void ChannelCompressor::resetLevels()
+{
+    for ( auto& pair : pairs )
+        pair.meters.reset();
+}
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    ChannelCompressor.h
+    Created: 17 Oct 2026 10:21:37pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParamSnapshot.h"
+#include "DynamicsKernel.h"
+#include "ChannelLinks.h"
+#include "BufferArena.h"
+
+/**
+ The compressor of a single band for OversampledCompressor and MultirateLowBand, which run it
+ over their resampled channels at their own rate.
+
+ Channels go through it a pair at a time, one CompressorLanes (with its look-ahead and meters)
+ per pair, so mono and stereo take one pair and 7.1.4 six. Like DynamicsKernel it only runs the
+ envelopes while no channel of a pair can leave unity gain, and linked channels (see ChannelLinks)
+ detect their group's detector, computed at the compressor's rate.
+ Unlike DynamicsKernel it does not share the gain of fully linked channels: a pair costs one
+ SIMD operation whether one or both of its channels compute a gain.
+ */
+struct ChannelCompressor
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+    static constexpr size_t NumLanes = 2;
+    static constexpr size_t MaxPairs = MaxChannels / NumLanes;
+
+    /**
+     The linked groups' detectors, maxSamples each at the compressor's rate, for as many groups
+     as numChannels can form. A compressor only uses them while it runs, so compressors that
+     run one after the other can share them.
+     */
+    struct Detectors
+    {
+        static size_t getArenaSize(size_t numChannels, size_t maxSamples);
+        void prepare(BufferArena& arena, size_t numChannels, size_t maxSamples);
+    private:
+        friend struct ChannelCompressor;
+
+        std::array<float*, ChannelLinks::MaxGroups> buffers {};
+        size_t maxSamples = 0;
+    };
+
+    //maxWindowSamples is the longest look-ahead at the compressor's rate, detectors must have
+    //been prepared for at least numChannels and the longest block
+    void prepare(size_t numChannels, int maxWindowSamples, const Detectors& detectors);
+    void reset();
+
+    //frees the look-ahead storage, the arena slices are released with the arena
+    void release();
+    size_t getAllocatedBytes() const;
+
+    //expFactor is -2 pi 1000 / the compressor's rate, windowSamples the look-ahead at that rate
+    void setSettings(const CompressorSettings& settings, double expFactor, int windowSamples);
+    void setLinkGroups(const ChannelLinks::Groups& groups);
+    void setLinkSettings(const LinkSettings& settings);
+
+    //compresses channels[0 .. numChannels) in place, i.e. delayed by the look-ahead window
+    void process(float* const* channels, size_t numChannels, size_t numSamples);
+
+    /**
+     For a band nobody hears: only runs the detectors, the channels are left untouched and only
+     metered as input. Sample i reaches the detectors repeats times if phase + i is a multiple of
+     interval and not at all otherwise, so the caller can hold or skip samples to bring them to the
+     compressor's rate.
+     */
+    void processDetector(const float* const* channels, size_t numChannels, size_t numSamples,
+                         size_t repeats, size_t interval = 1, size_t phase = 0);
+
+    //metered at the compressor's rate, since the last resetLevels()
+    BandLevels getLevels() const;
+    void resetLevels();
+private:
+    struct Pair
+    {
+        CompressorLanes<NumLanes> compressor;
+        LookAheadLanes<NumLanes> lookAhead;
+        LevelMeterLanes<NumLanes> meters;
+    };
+
+    //fills the linked groups' detectors from channels, detectors[ch] gets the one channel ch detects (nullptr: its own samples)
+    void computeDetectors(const float* const* channels, size_t numChannels, size_t numSamples, std::array<const float*, MaxChannels>& detectors);
+    void processPair(Pair& pair, float* const* channels, const float* const* detectors, size_t numChannels, size_t numSamples);
+
+    std::array<Pair, MaxPairs> pairs;
+    size_t numPreparedChannels = 0;
+
+    ChannelLinks links;
+    ChannelLinks::Groups linkGroups = ChannelLinks::getUnlinkedGroups();
+    Detectors linkedDetectors;
+};
@@ -0,0 +1,215 @@
+/*
+  ==============================================================================
+
+    ChannelLinks.h
+    Created: 17 Oct 2026 9:48:05pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FastMath.h"
+#include "Params.h"
+#include "ParamSnapshot.h"
+
+/**
+ Which channels of a band share a detector.
+
+ Every channel has a group number, channels with the same number are linked: their detector
+ is the loudest (or the average, see Params::LinkDetector) |sample| of the group, sample by
+ sample, so they all see the same level and are pulled down together, which keeps the balance
+ and the image of the group while it is compressed. A channel whose number no other channel has
+ is on its own, as if unlinked.
+
+ The compressors compute one detector per linked group with computeDetector() ahead of their
+ sample loop and feed it to the lanes of the group in place of |sample|, so linking costs a
+ pass over the group's channels and does not care how the channels are spread over SIMD lanes.
+ Below a link amount of 1 each channel detects getLinkedLevel(), its own |sample| moved that
+ far towards the group's detector.
+
+ Fully linked channels see the same level and so get the same gain: sharesGain() tells the
+ compressors they may compute it once, for the group's leader (its first channel), and apply
+ it to the followers (the others).
+ */
+struct ChannelLinks
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+
+    //a linked group has at least two channels
+    static constexpr size_t MaxGroups = MaxChannels / 2;
+
+    //the group number of every channel
+    using Groups = std::array<int, MaxChannels>;
+
+    static Groups getUnlinkedGroups()
+    {
+        Groups groups;
+        std::iota(groups.begin(), groups.end(), 0);
+        return groups;
+    }
+
+    static Groups getAllLinkedGroups()
+    {
+        Groups groups;
+        groups.fill(0);
+        return groups;
+    }
+
+    //see Params::ChannelLink::Pairs
+    static Groups getLayoutPairs(const juce::AudioChannelSet& layout)
+    {
+        auto groups = getUnlinkedGroups();
+        auto numChannels = juce::jmin(static_cast<size_t>(layout.size()), MaxChannels);
+
+        if ( layout.getAmbisonicOrder() >= 0 )
+            return getAllLinkedGroups();
+
+        if ( layout.isDiscreteLayout() )
+        {
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+                groups[ch] = static_cast<int>(ch / 2);
+
+            return groups;
+        }
+
+        using Type = juce::AudioChannelSet::ChannelType;
+        static constexpr std::array<std::pair<Type, Type>, 9> mirrors
+        {{
+            { juce::AudioChannelSet::left, juce::AudioChannelSet::right },
+            { juce::AudioChannelSet::leftCentre, juce::AudioChannelSet::rightCentre },
+            { juce::AudioChannelSet::leftSurround, juce::AudioChannelSet::rightSurround },
+            { juce::AudioChannelSet::leftSurroundSide, juce::AudioChannelSet::rightSurroundSide },
+            { juce::AudioChannelSet::leftSurroundRear, juce::AudioChannelSet::rightSurroundRear },
+            { juce::AudioChannelSet::wideLeft, juce::AudioChannelSet::wideRight },
+            { juce::AudioChannelSet::topFrontLeft, juce::AudioChannelSet::topFrontRight },
+            { juce::AudioChannelSet::topSideLeft, juce::AudioChannelSet::topSideRight },
+            { juce::AudioChannelSet::topRearLeft, juce::AudioChannelSet::topRearRight },
+        }};
+
+        for ( const auto& [leftType, rightType] : mirrors )
+        {
+            auto leftChannel = layout.getChannelIndexForType(leftType);
+            auto rightChannel = layout.getChannelIndexForType(rightType);
+
+            //the right one joins the left one's group
+            if ( juce::isPositiveAndBelow(leftChannel, static_cast<int>(numChannels))
+                 && juce::isPositiveAndBelow(rightChannel, static_cast<int>(numChannels)) )
+                groups[static_cast<size_t>(rightChannel)] = groups[static_cast<size_t>(leftChannel)];
+        }
+
+        return groups;
+    }
+
+    //channels from numChannels on are ignored
+    void setGroups(const Groups& groups, size_t numChannels)
+    {
+        jassert( numChannels <= MaxChannels );
+
+        channelGroups.fill(-1);
+        numGroups = 0;
+
+        for ( size_t ch = 0; ch < numChannels; ++ch )
+        {
+            if ( channelGroups[ch] >= 0 )
+                continue;
+
+            auto& group = groupChannels[numGroups];
+            size_t count = 0;
+            for ( auto other = ch; other < numChannels; ++other )
+            {
+                if ( groups[other] == groups[ch] )
+                    group[count++] = other;
+            }
+
+            if ( count < 2 )
+                continue;
+
+            for ( size_t i = 0; i < count; ++i )
+                channelGroups[group[i]] = static_cast<int>(numGroups);
+
+            groupSizes[numGroups++] = count;
+        }
+    }
+
+    void setSettings(const LinkSettings& newSettings)
+    {
+        settings = newSettings;
+        settings.amount = juce::jlimit(0.f, 1.f, settings.amount);
+    }
+
+    bool isLinked() const { return numGroups > 0; }
+    bool isFullyLinked() const { return settings.amount >= 1.f; }
+    bool sharesGain() const { return isLinked() && isFullyLinked(); }
+    float getAmount() const { return settings.amount; }
+    size_t getNumGroups() const { return numGroups; }
+
+    //the linked group of channel, -1 when it is on its own
+    int getGroup(size_t channel) const { return channelGroups[channel]; }
+
+    //the channel whose gain a linked group shares, its first one
+    size_t getLeader(size_t group) const { return groupChannels[group][0]; }
+    bool isFollower(size_t channel) const { return channelGroups[channel] >= 0 && getLeader(static_cast<size_t>(channelGroups[channel])) != channel; }
+
+    //bit i is set for every channel i linked with channel, only channel's own bit when it is on its own
+    uint32_t getMembers(size_t channel) const
+    {
+        auto group = channelGroups[channel];
+        if ( group < 0 )
+            return 1u << channel;
+
+        uint32_t members = 0;
+        for ( size_t i = 0; i < groupSizes[static_cast<size_t>(group)]; ++i )
+            members |= 1u << groupChannels[static_cast<size_t>(group)][i];
+
+        return members;
+    }
+
+    //the loudest or the average |sample| of the group's channels, channels holds every channel of the band
+    template<typename SampleType>
+    void computeDetector(size_t group, const SampleType* const* channels, size_t numSamples, float* detector) const
+    {
+        jassert( group < numGroups );
+
+        const auto* first = channels[groupChannels[group][0]];
+        for ( size_t i = 0; i < numSamples; ++i )
+            detector[i] = static_cast<float>(std::abs(first[i]));
+
+        if ( settings.detector == Params::LinkDetector::Mean )
+        {
+            for ( size_t k = 1; k < groupSizes[group]; ++k )
+            {
+                const auto* samples = channels[groupChannels[group][k]];
+                for ( size_t i = 0; i < numSamples; ++i )
+                    detector[i] += static_cast<float>(std::abs(samples[i]));
+            }
+
+            auto scale = 1.f / static_cast<float>(groupSizes[group]);
+            for ( size_t i = 0; i < numSamples; ++i )
+                detector[i] *= scale;
+
+            return;
+        }
+
+        for ( size_t k = 1; k < groupSizes[group]; ++k )
+        {
+            const auto* samples = channels[groupChannels[group][k]];
+            for ( size_t i = 0; i < numSamples; ++i )
+                detector[i] = FastMath::maxNonNegative(detector[i], static_cast<float>(std::abs(samples[i])));
+        }
+    }
+
+    //what a linked channel detects: its own level moved amount of the way to the group's detector
+    static forcedinline float getLinkedLevel(float ownLevel, float detector, float amount)
+    {
+        return ownLevel + amount * (detector - ownLevel);
+    }
+private:
+    std::array<int, MaxChannels> channelGroups = [] { std::array<int, MaxChannels> groups; groups.fill(-1); return groups; }();
+    std::array<std::array<size_t, MaxChannels>, MaxGroups> groupChannels {};
+    std::array<size_t, MaxGroups> groupSizes {};
+    size_t numGroups = 0;
+    LinkSettings settings;
+};
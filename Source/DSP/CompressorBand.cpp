@@ -1,45 +1,75 @@
-/*
-  ==============================================================================
-
-    CompressorBand.cpp
-    Created: 26 May 2024 9:34:44am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#include "CompressorBand.h"
-
-void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
-{
-    compressor.prepare(spec);
-}
-
-void CompressorBand::updateCompressorSettings()
-{
-    compressor.setAttack(attack->get());
-    compressor.setRelease(release->get());
-    compressor.setThreshold(threshold->get());
-    compressor.setRatio( ratio->getCurrentChoiceName().getFloatValue() );
-}
-
-void CompressorBand::process(juce::AudioBuffer<float>& buffer)
-{
-    auto preRMS = computeRMSLevel(buffer);
-    auto block = juce::dsp::AudioBlock<float>(buffer);
-    auto context = juce::dsp::ProcessContextReplacing<float>(block);
-    
-    context.isBypassed = bypass->get();
-    
-    compressor.process(context);
-    
-    auto postRMS = computeRMSLevel(buffer);
-    
-    auto convertToDb = [](auto input)
-    {
-        return juce::Decibels::gainToDecibels(input);
-    };
-    
-    rmsInputLevelDb.store(convertToDb(preRMS));
-    rmsOutputLevelDb.store(convertToDb(postRMS));
-}
+/*
+  ==============================================================================
+
+    CompressorBand.cpp
+    Created: 26 May 2024 9:34:44am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "CompressorBand.h"
+#include "Params.h"
+
+void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    juce::ignoreUnused(spec);
+    
+    settings.invalidate();
+    publishLevels({});
+}
+
+bool CompressorBand::updateCompressorSettings()
+{
+    const auto& ratioChoices = Params::GetRatioChoices();
+    auto ratioIndex = ratio->getIndex();
+    jassert( juce::isPositiveAndBelow(ratioIndex, static_cast<int>(ratioChoices.size())) );
+    
+    CompressorSettings newSettings;
+    newSettings.attack = attack->get();
+    newSettings.release = release->get();
+    newSettings.threshold = threshold->get();
+    newSettings.ratio = static_cast<float>(ratioChoices[static_cast<size_t>(ratioIndex)]);
+    newSettings.bypassed = bypass->get();
+    newSettings.lookAhead = lookAhead->get();
+    
+    return settings.update(newSettings);
+}
+
+void CompressorBand::publishLevels(const BandLevels& levels)
+{
+    auto sequence = levelsSequence.load(std::memory_order_relaxed);
+    levelsSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    rmsInput.store(levels.rmsInput, std::memory_order_relaxed);
+    rmsOutput.store(levels.rmsOutput, std::memory_order_relaxed);
+    peakInput.store(levels.peakInput, std::memory_order_relaxed);
+    peakOutput.store(levels.peakOutput, std::memory_order_relaxed);
+    minGain.store(levels.minGain, std::memory_order_relaxed);
+    maxGain.store(levels.maxGain, std::memory_order_relaxed);
+    
+    levelsSequence.store(sequence + 2, std::memory_order_release);
+}
+
+BandLevels CompressorBand::getLevels() const
+{
+    BandLevels levels;
+    
+    for ( ;; )
+    {
+        auto before = levelsSequence.load(std::memory_order_acquire);
+        
+        levels.rmsInput = rmsInput.load(std::memory_order_relaxed);
+        levels.rmsOutput = rmsOutput.load(std::memory_order_relaxed);
+        levels.peakInput = peakInput.load(std::memory_order_relaxed);
+        levels.peakOutput = peakOutput.load(std::memory_order_relaxed);
+        levels.minGain = minGain.load(std::memory_order_relaxed);
+        levels.maxGain = maxGain.load(std::memory_order_relaxed);
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        
+        if ( (before & 1) == 0 && levelsSequence.load(std::memory_order_relaxed) == before )
+            return levels;
+    }
+}
@@ -1,55 +1,54 @@
-/*
-  ==============================================================================
-
-    CompressorBand.h
-    Created: 26 May 2024 9:34:44am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "../GUI/Utilities.h"
-
-struct CompressorBand
-{
-    juce::AudioParameterFloat* attack { nullptr };
-    juce::AudioParameterFloat* release { nullptr };
-    juce::AudioParameterFloat* threshold { nullptr };
-    juce::AudioParameterChoice* ratio { nullptr };
-    juce::AudioParameterBool* bypass { nullptr };
-    juce::AudioParameterBool* mute { nullptr };
-    juce::AudioParameterBool* solo { nullptr };
-
-    
-    void prepare(const juce::dsp::ProcessSpec& spec);
-    
-    void updateCompressorSettings();
-    
-    void process(juce::AudioBuffer<float>& buffer);
-    
-    float getRMSOutputLevelDb() const { return rmsOutputLevelDb; }
-    float getRMSInputLevelDb() const { return rmsInputLevelDb; }
-private:
-    juce::dsp::Compressor<float> compressor;
-    
-    std::atomic<float> rmsInputLevelDb { NEGATIVE_INFINITY };
-    std::atomic<float> rmsOutputLevelDb { NEGATIVE_INFINITY };
-    
-    template<typename T>
-    float computeRMSLevel(const T& buffer)
-    {
-        int numChannels = static_cast<int>(buffer.getNumChannels());
-        int numSamples = static_cast<int>(buffer.getNumSamples());
-        auto rms = 0.f;
-        for ( int chan = 0; chan < numChannels; ++chan )
-        {
-            rms += buffer.getRMSLevel(chan, 0, numSamples);
-        }
-        
-        rms /= static_cast<float>(numChannels);
-        return rms;
-    }
-};
+/*
+  ==============================================================================
+
+    CompressorBand.h
+    Created: 26 May 2024 9:34:44am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../GUI/Utilities.h"
+#include "ParamSnapshot.h"
+#include "LevelMeters.h"
+
+/**
+ Parameters and meters of one band. The compression itself runs in DynamicsKernel,
+ which processes all bands together.
+ */
+struct CompressorBand
+{
+    juce::AudioParameterFloat* attack { nullptr };
+    juce::AudioParameterFloat* release { nullptr };
+    juce::AudioParameterFloat* threshold { nullptr };
+    juce::AudioParameterChoice* ratio { nullptr };
+    juce::AudioParameterBool* bypass { nullptr };
+    juce::AudioParameterBool* mute { nullptr };
+    juce::AudioParameterBool* solo { nullptr };
+    juce::AudioParameterChoice* oversampling { nullptr };
+    juce::AudioParameterFloat* lookAhead { nullptr };
+
+    
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    
+    //returns true when one of the compressor parameters changed since the last call
+    bool updateCompressorSettings();
+    const CompressorSettings& getSettings() const { return settings.get(); }
+    
+    //audio thread: replaces the published levels with what the band did since the last call
+    void publishLevels(const BandLevels& levels);
+    
+    //any thread: the last published levels, all from the same publishLevels() call
+    BandLevels getLevels() const;
+private:
+    ParamSnapshot<CompressorSettings> settings;
+    
+    //a sequence lock: odd while publishLevels() is writing, readers retry until they saw an even,
+    //unchanged sequence around their copy, so they never mix two blocks and never block the writer
+    std::atomic<uint32_t> levelsSequence { 0 };
+    std::atomic<float> rmsInput { 0.f }, rmsOutput { 0.f }, peakInput { 0.f }, peakOutput { 0.f };
+    std::atomic<float> minGain { 1.f }, maxGain { 1.f };
+};
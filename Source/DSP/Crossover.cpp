@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    Crossover.cpp
+    Created: 17 Oct 2026 10:02:17am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "Crossover.h"
+
+void Crossover::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    jassert( spec.numChannels <= MaxChannels );
+
+    table = CrossoverCoefficientTable::getShared(spec.sampleRate);
+
+    setCutoffFrequencies(cutoffFrequencies);
+    reset();
+}
+
+void Crossover::reset()
+{
+    forEachKernel([](auto& kernel) { kernel.reset(); });
+}
+
+void Crossover::setCutoffFrequencies(const Cutoffs& cutoffs, int numRampSamples)
+{
+    cutoffFrequencies = cutoffs;
+
+    //before prepare() there is nothing to set yet, prepare() picks the cutoffs up
+    if ( table == nullptr )
+        return;
+
+    forEachKernel([&](auto& kernel)
+    {
+        for ( size_t ch = 0; ch < kernel.getNumSignals(); ++ch )
+            kernel.setCutoffFrequencies(ch, cutoffFrequencies, *table, numRampSamples);
+    });
+}
+
+void Crossover::setSlopes(const Slopes& slopes)
+{
+    forEachKernel([&](auto& kernel) { kernel.setSlopes(slopes); });
+}
+
+template<typename SampleType>
+void Crossover::process(const juce::dsp::AudioBlock<SampleType>& input, const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+{
+    auto numChannels = input.getNumChannels();
+    auto numSamples = input.getNumSamples();
+
+    jassert( numChannels > 0 && numChannels <= MaxChannels );
+    for ( auto& band : bands )
+    {
+        juce::ignoreUnused(band);
+        jassert( band.getNumChannels() >= numChannels && band.getNumSamples() >= numSamples );
+    }
+
+    if ( numChannels == 1 )
+    {
+        processChannels(std::get<Kernel<1, SampleType>>(kernels), input, bands, 0, 1);
+    }
+    else if ( numChannels == 2 )
+    {
+        processChannels(std::get<Kernel<2, SampleType>>(kernels), input, bands, 0, 2);
+    }
+    else
+    {
+        auto& wide = std::get<WideKernels<SampleType>>(wideKernels);
+        for ( size_t first = 0; first < numChannels; first += WideChannels )
+            processChannels(wide[first / WideChannels], input, bands, first, juce::jmin(WideChannels, numChannels - first));
+    }
+}
+
+template<size_t NumChannels, typename SampleType>
+void Crossover::processChannels(Kernel<NumChannels, SampleType>& kernel, const juce::dsp::AudioBlock<SampleType>& input,
+                                const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands, size_t firstChannel, size_t numChannels)
+{
+    using KernelType = Kernel<NumChannels, SampleType>;
+
+    //mono and stereo always fill their kernel, so their channel loops have a constant length and unroll
+    auto numUsedChannels = NumChannels < WideChannels ? NumChannels : numChannels;
+    auto numSamples = input.getNumSamples();
+
+    jassert( numChannels <= NumChannels );
+
+    std::array<const SampleType*, NumChannels> in {};
+    std::array<std::array<SampleType*, NumChannels>, NumBands> out {};
+    for ( size_t ch = 0; ch < numUsedChannels; ++ch )
+    {
+        in[ch] = input.getChannelPointer(firstChannel + ch);
+        for ( size_t band = 0; band < NumBands; ++band )
+            out[band][ch] = bands[band].getChannelPointer(firstChannel + ch);
+    }
+
+    //a local copy lets the compiler keep coefficients and state in registers for the whole loop
+    auto state = kernel;
+
+    //the lanes of missing channels stay silent
+    typename KernelType::Frame inFrame {};
+    std::array<typename KernelType::Frame, NumBands> bandFrames;
+
+    auto processSample = [&](size_t i)
+    {
+        for ( size_t ch = 0; ch < numUsedChannels; ++ch )
+            inFrame[ch] = in[ch][i];
+
+        state.processFrame(inFrame, bandFrames);
+
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            for ( size_t ch = 0; ch < numUsedChannels; ++ch )
+                out[band][ch][i] = bandFrames[band][ch];
+        }
+    };
+
+    //while the cutoffs glide, the coefficients move on after every sample
+    size_t i = 0;
+    for ( ; i < numSamples && state.isRamping(); ++i )
+    {
+        processSample(i);
+        state.advanceCutoffRamps();
+    }
+
+    for ( ; i < numSamples; ++i )
+        processSample(i);
+
+    state.snapToZero();
+    kernel = state;
+}
+
+template void Crossover::process<float>(const juce::dsp::AudioBlock<float>&, const std::array<juce::dsp::AudioBlock<float>, NumBands>&);
+template void Crossover::process<double>(const juce::dsp::AudioBlock<double>&, const std::array<juce::dsp::AudioBlock<double>, NumBands>&);
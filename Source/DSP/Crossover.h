@@ -0,0 +1,505 @@
+/*
+  ==============================================================================
+
+    Crossover.h
+    Created: 17 Oct 2026 10:02:17am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Params.h"
+#include "CrossoverCoefficientTable.h"
+
+/**
+ NumBands Linkwitz-Riley crossover for NumSignals independent signals
+ (channels, or whole streams), all processed side by side in SIMD lanes.
+
+ The split tree is built at compile time: crossover i splits what is left above band i - 1
+ into band i (LP) and the rest (HP), and every band already split off goes through an
+ allpass at that crossover's cutoff, so all bands have the same phase and sum flat.
+ For three bands at 24 dB/oct this is the chain
+
+         fc0     fc1
+         LP1,    AP2,
+         HP1,    LP2,
+                 HP2;
+
+ built from juce::dsp::LinkwitzRileyFilter<SampleType>, with the same TPT sections and
+ coefficients. Sections that run in parallel are packed into lane groups per crossover i:
+
+     allPassSplit   allpasses of bands 0 .. i-1 | shared first section of LPi/HPi   (i + 1) * NumSignals lanes
+     pairs          later LPi sections | later HPi sections                         2 * NumSignals lanes
+     secondAllPass  second allpass section of bands 0 .. i-1 (LR8 only)             i * NumSignals lanes
+
+ Each crossover has its own slope (see CrossoverSlope), which sets how many of these
+ sections run. Every lane has its own cutoff, so signals may use different cutoffs,
+ but a crossover's slope is the same for all signals.
+
+ The cutoffs come in through a CrossoverCoefficientTable, which saves the tan() and is shared
+ by every instance at the same sample rate.
+
+ Cutoff changes can be ramped: g = tan(pi fc / fs) then moves linearly, one step per sample,
+ and the sections follow it every sample. TPT sections stay well behaved under that kind of
+ modulation as long as h = 1 / (1 + R2 g + g^2) matches g, so h is recomputed with it, one
+ division per lane. g is only looked up at the ends of the ramp, and when nothing
+ moves the sample loop is the same as without ramps.
+ */
+template<size_t NumSignals, size_t NumBands = 3, typename SampleType = float>
+struct CrossoverKernel
+{
+    static_assert( NumBands >= 2, "a crossover needs at least two bands" );
+
+    static constexpr size_t NumCrossovers = NumBands - 1;
+
+    static constexpr size_t getNumSignals() { return NumSignals; }
+
+    using Frame = std::array<SampleType, NumSignals>;
+    using Cutoffs = std::array<float, NumCrossovers>;
+    using Slopes = std::array<Params::CrossoverSlope, NumCrossovers>;
+
+    void reset()
+    {
+        forEachStage([](auto& stage) { stage.reset(); });
+    }
+
+    //numRampSamples > 0 glides from the current cutoffs over that many calls to advanceCutoffRamps()
+    void setCutoffFrequencies(size_t signal, const Cutoffs& cutoffs, const CrossoverCoefficientTable& table, int numRampSamples = 0)
+    {
+        jassert( signal < NumSignals );
+
+        size_t crossover = 0;
+        auto moves = false;
+        forEachStage([&](auto& stage)
+        {
+            auto cutoff = cutoffs[crossover++];
+            auto target = static_cast<SampleType>(table.getG(cutoff));
+
+            stage.targetG[signal] = target;
+            moves = moves || target != stage.g[signal];
+
+            if ( numRampSamples > 0 )
+            {
+                stage.gStep[signal] = (target - stage.g[signal]) / static_cast<SampleType>(numRampSamples);
+            }
+            else
+            {
+                stage.g[signal] = target;
+                stage.updateCoefficients(signal);
+            }
+        });
+
+        rampSamplesLeft[signal] = moves ? juce::jmax(0, numRampSamples) : 0;
+        if ( numRampSamples > 0 && ! moves )
+            finishRamp(signal);
+
+        ramping = std::any_of(rampSamplesLeft.begin(), rampSamplesLeft.end(), [](int left) { return left > 0; });
+    }
+
+    bool isRamping() const { return ramping; }
+
+    //moves every ramping cutoff one sample on, call it after each processFrame() while isRamping()
+    forcedinline void advanceCutoffRamps()
+    {
+        auto stillRamping = false;
+        for ( size_t signal = 0; signal < NumSignals; ++signal )
+        {
+            if ( rampSamplesLeft[signal] > 0 )
+            {
+                --rampSamplesLeft[signal];
+                stillRamping = stillRamping || rampSamplesLeft[signal] > 0;
+            }
+        }
+
+        if ( ! stillRamping )
+        {
+            //the exact target coefficients, as if they had been set without a ramp
+            for ( size_t signal = 0; signal < NumSignals; ++signal )
+                finishRamp(signal);
+
+            ramping = false;
+            return;
+        }
+
+        forEachStage([&](auto& stage)
+        {
+            for ( size_t signal = 0; signal < NumSignals; ++signal )
+                stage.g[signal] = rampSamplesLeft[signal] > 0 ? stage.g[signal] + stage.gStep[signal] : stage.targetG[signal];
+
+            stage.followG();
+        });
+    }
+
+    //a crossover whose slope changes starts over from silence
+    void setSlopes(const Slopes& slopes)
+    {
+        size_t crossover = 0;
+        forEachStage([&](auto& stage)
+        {
+            auto slope = slopes[crossover++];
+            if ( slope == stage.slope )
+                return;
+
+            stage.slope = slope;
+            stage.reset();
+            for ( size_t signal = 0; signal < NumSignals; ++signal )
+                stage.updateCoefficients(signal);
+        });
+    }
+
+    forcedinline void processFrame(const Frame& input, std::array<Frame, NumBands>& bands)
+    {
+        auto rest = input;
+        processStages(rest, bands, std::make_index_sequence<NumCrossovers>());
+        bands[NumCrossovers] = rest;
+    }
+
+    void snapToZero()
+    {
+        forEachStage([](auto& stage)
+        {
+            stage.allPassSplit.snapToZero();
+            for ( auto& pair : stage.pairs )
+                pair.snapToZero();
+
+            stage.secondAllPass.snapToZero();
+        });
+    }
+private:
+    template<size_t NumLanes>
+    using Lanes = std::array<SampleType, NumLanes>;
+
+    void finishRamp(size_t signal)
+    {
+        forEachStage([&](auto& stage)
+        {
+            stage.g[signal] = stage.targetG[signal];
+            stage.gStep[signal] = 0;
+            stage.updateCoefficients(signal);
+        });
+    }
+
+    //damping of the cascaded Butterworth sections each slope is made of
+    struct SlopeSections
+    {
+        static SampleType lr2() { return 2; }
+        static SampleType lr4() { return static_cast<SampleType>(std::sqrt(2.0)); }
+        static SampleType lr8First() { return static_cast<SampleType>(2.0 * std::cos(juce::MathConstants<double>::pi / 8.0)); }
+        static SampleType lr8Second() { return static_cast<SampleType>(2.0 * std::cos(3.0 * juce::MathConstants<double>::pi / 8.0)); }
+    };
+
+    //NumLanes 2nd order TPT state variable sections, each identical to a stage of juce::dsp::LinkwitzRileyFilter
+    template<size_t NumLanes>
+    struct Sections
+    {
+        alignas(16) Lanes<NumLanes> g {}, R2 {}, h {};
+        alignas(16) Lanes<NumLanes> s1 {}, s2 {};
+
+        static constexpr size_t size() { return NumLanes; }
+
+        void setCoefficients(size_t lane, SampleType newG, SampleType newR2)
+        {
+            g[lane] = newG;
+            R2[lane] = newR2;
+            h[lane] = static_cast<SampleType>(1.0 / (1.0 + newR2 * newG + newG * newG));
+        }
+
+        //lane l takes g and h of signal l % NumSignals, as laid out by Stage
+        forcedinline void followG(const Lanes<NumSignals>& signalG, const Lanes<NumSignals>& signalH)
+        {
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+            {
+                g[lane] = signalG[lane % NumSignals];
+                h[lane] = signalH[lane % NumSignals];
+            }
+        }
+
+        void reset()
+        {
+            s1.fill(0);
+            s2.fill(0);
+        }
+
+        void snapToZero()
+        {
+           #if JUCE_DSP_ENABLE_SNAP_TO_ZERO
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+            {
+                juce::dsp::util::snapToZero(s1[lane]);
+                juce::dsp::util::snapToZero(s2[lane]);
+            }
+           #endif
+        }
+
+        forcedinline void tick(const Lanes<NumLanes>& input, Lanes<NumLanes>& yL, Lanes<NumLanes>& yB, Lanes<NumLanes>& yH)
+        {
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+            {
+                yH[lane] = (input[lane] - (R2[lane] + g[lane]) * s1[lane] - s2[lane]) * h[lane];
+
+                yB[lane] = g[lane] * yH[lane] + s1[lane];
+                s1[lane] = g[lane] * yH[lane] + yB[lane];
+
+                yL[lane] = g[lane] * yB[lane] + s2[lane];
+                s2[lane] = g[lane] * yB[lane] + yL[lane];
+            }
+        }
+
+        //2nd order allpass yL - R2 yB + yH, as in juce::dsp::LinkwitzRileyFilter
+        forcedinline void tickAllPass(const Lanes<NumLanes>& input, Lanes<NumLanes>& output)
+        {
+            Lanes<NumLanes> yL, yB, yH;
+            tick(input, yL, yB, yH);
+
+            for ( size_t lane = 0; lane < NumLanes; ++lane )
+                output[lane] = yL[lane] - R2[lane] * yB[lane] + yH[lane];
+        }
+    };
+
+    template<size_t Crossover>
+    struct Stage
+    {
+        static constexpr size_t NumAllPassLanes = Crossover * NumSignals;
+        static constexpr size_t MaxPairSections = 3;
+
+        Sections<NumAllPassLanes + NumSignals> allPassSplit;
+        std::array<Sections<2 * NumSignals>, MaxPairSections> pairs;
+        Sections<NumAllPassLanes> secondAllPass;
+
+        //g of every signal, and where a ramp takes it
+        Lanes<NumSignals> g {}, targetG {}, gStep {};
+        Params::CrossoverSlope slope = Params::CrossoverSlope::LR4;
+
+        void reset()
+        {
+            allPassSplit.reset();
+            for ( auto& pair : pairs )
+                pair.reset();
+
+            secondAllPass.reset();
+        }
+
+        //damping of the first section, shared by the split and the allpasses of the bands below
+        SampleType getFirstR2() const
+        {
+            using Slope = Params::CrossoverSlope;
+            return slope == Slope::LR2 ? SlopeSections::lr2()
+                 : slope == Slope::LR4 ? SlopeSections::lr4() : SlopeSections::lr8First();
+        }
+
+        void updateCoefficients(size_t signal)
+        {
+            using Slope = Params::CrossoverSlope;
+
+            auto first = getFirstR2();
+
+            for ( size_t lane = signal; lane < allPassSplit.size(); lane += NumSignals )
+                allPassSplit.setCoefficients(lane, g[signal], first);
+
+            std::array<SampleType, MaxPairSections> pairR2 { first, SlopeSections::lr8First(), SlopeSections::lr8Second() };
+            if ( slope == Slope::LR8 )
+                pairR2[0] = SlopeSections::lr8Second();
+
+            for ( size_t i = 0; i < pairs.size(); ++i )
+            {
+                pairs[i].setCoefficients(signal, g[signal], pairR2[i]);
+                pairs[i].setCoefficients(NumSignals + signal, g[signal], pairR2[i]);
+            }
+
+            for ( size_t lane = signal; lane < secondAllPass.size(); lane += NumSignals )
+                secondAllPass.setCoefficients(lane, g[signal], SlopeSections::lr8Second());
+        }
+
+        int getNumPairSections() const
+        {
+            using Slope = Params::CrossoverSlope;
+            return slope == Slope::LR2 ? 0 : slope == Slope::LR4 ? 1 : 3;
+        }
+
+        //puts g into the sections the slope runs, the others catch up in updateCoefficients().
+        //h only depends on g and the damping, and a slope has at most two dampings (the LR8
+        //sections alternate lr8First and lr8Second), so it takes two divisions per signal at most
+        forcedinline void followG()
+        {
+            auto first = getFirstR2();
+            Lanes<NumSignals> hFirst;
+            for ( size_t s = 0; s < NumSignals; ++s )
+                hFirst[s] = SampleType(1) / (SampleType(1) + first * g[s] + g[s] * g[s]);
+
+            allPassSplit.followG(g, hFirst);
+
+            if ( slope == Params::CrossoverSlope::LR4 )
+                pairs[0].followG(g, hFirst);
+
+            if ( slope == Params::CrossoverSlope::LR8 )
+            {
+                auto second = SlopeSections::lr8Second();
+                Lanes<NumSignals> hSecond;
+                for ( size_t s = 0; s < NumSignals; ++s )
+                    hSecond[s] = SampleType(1) / (SampleType(1) + second * g[s] + g[s] * g[s]);
+
+                pairs[0].followG(g, hSecond);
+                pairs[1].followG(g, hFirst);
+                pairs[2].followG(g, hSecond);
+                secondAllPass.followG(g, hSecond);
+            }
+        }
+    };
+
+    //splits rest into bands[Crossover] and a new rest, and runs the allpasses of the bands below
+    template<size_t Crossover>
+    forcedinline void processStage(Frame& rest, std::array<Frame, NumBands>& bands)
+    {
+        using StageType = Stage<Crossover>;
+        constexpr auto numAllPassLanes = StageType::NumAllPassLanes;
+        auto& stage = std::get<Crossover>(stages);
+        auto lr2 = stage.slope == Params::CrossoverSlope::LR2;
+
+        Lanes<numAllPassLanes + NumSignals> input, yL, yB, yH;
+        for ( size_t lane = 0; lane < numAllPassLanes; ++lane )
+            input[lane] = bands[lane / NumSignals][lane % NumSignals];
+
+        for ( size_t s = 0; s < NumSignals; ++s )
+            input[numAllPassLanes + s] = rest[s];
+
+        stage.allPassSplit.tick(input, yL, yB, yH);
+
+        //the sum of a LR2 split is LP - HP, a 1st order allpass, the others sum to their cascaded 2nd order allpasses
+        Lanes<numAllPassLanes> allPassed;
+        if ( lr2 )
+        {
+            for ( size_t lane = 0; lane < numAllPassLanes; ++lane )
+                allPassed[lane] = yL[lane] - yH[lane];
+        }
+        else
+        {
+            for ( size_t lane = 0; lane < numAllPassLanes; ++lane )
+                allPassed[lane] = yL[lane] - stage.allPassSplit.R2[lane] * yB[lane] + yH[lane];
+
+            if ( stage.slope == Params::CrossoverSlope::LR8 )
+                stage.secondAllPass.tickAllPass(allPassed, allPassed);
+        }
+
+        for ( size_t lane = 0; lane < numAllPassLanes; ++lane )
+            bands[lane / NumSignals][lane % NumSignals] = allPassed[lane];
+
+        Lanes<2 * NumSignals> pairL, pairB, pairH;
+        for ( size_t s = 0; s < NumSignals; ++s )
+        {
+            pairL[s] = yL[numAllPassLanes + s];
+            pairH[NumSignals + s] = yH[numAllPassLanes + s];
+        }
+
+        //the LP half of each pair continues from yL, the HP half from yH
+        Lanes<2 * NumSignals> pairInput;
+        for ( int i = 0; i < stage.getNumPairSections(); ++i )
+        {
+            for ( size_t s = 0; s < NumSignals; ++s )
+            {
+                pairInput[s] = pairL[s];
+                pairInput[NumSignals + s] = pairH[NumSignals + s];
+            }
+
+            stage.pairs[static_cast<size_t>(i)].tick(pairInput, pairL, pairB, pairH);
+        }
+
+        for ( size_t s = 0; s < NumSignals; ++s )
+        {
+            bands[Crossover][s] = pairL[s];
+            rest[s] = pairH[NumSignals + s];
+        }
+
+        //LR2 inverts the HP side, otherwise its bands would cancel at the cutoff
+        if ( lr2 )
+        {
+            for ( auto& sample : rest )
+                sample = -sample;
+        }
+    }
+
+    template<size_t... Crossovers>
+    forcedinline void processStages(Frame& rest, std::array<Frame, NumBands>& bands, std::index_sequence<Crossovers...>)
+    {
+        (processStage<Crossovers>(rest, bands), ...);
+    }
+
+    template<typename Function>
+    void forEachStage(Function&& function)
+    {
+        std::apply([&](auto&... stage) { (function(stage), ...); }, stages);
+    }
+
+    template<typename Sequence>
+    struct StageList;
+
+    template<size_t... Crossovers>
+    struct StageList<std::index_sequence<Crossovers...>>
+    {
+        using Type = std::tuple<Stage<Crossovers>...>;
+    };
+
+    typename StageList<std::make_index_sequence<NumCrossovers>>::Type stages;
+
+    std::array<int, NumSignals> rampSamplesLeft {};
+    bool ramping = false;
+};
+
+/**
+ The processor's crossover, Params::NumBands bands, in float or double (see
+ SkwiezorMBAudioProcessor::processBlock()). There is a kernel per channel count and precision,
+ so mono runs one lane instead of a silent second one and the channel loops have a fixed length.
+ Wider layouts run WideChannels channels per kernel, side by side in its lanes (4 floats fill
+ an SSE/NEON register in the first stage, 8 an AVX one in the next), the last kernel partly on silence:
+ two kernels for 5.1, three for 7.1.4.
+ They all follow the same cutoffs and slopes, only the ones that match the block run.
+ */
+struct Crossover
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+    static constexpr size_t WideChannels = 4;
+    static constexpr size_t NumBands = Params::NumBands;
+
+    static_assert( MaxChannels % WideChannels == 0, "the wide kernels cover every channel" );
+
+    template<size_t NumChannels, typename SampleType>
+    using Kernel = CrossoverKernel<NumChannels, NumBands, SampleType>;
+
+    template<typename SampleType>
+    using WideKernels = std::array<Kernel<WideChannels, SampleType>, MaxChannels / WideChannels>;
+
+    using Cutoffs = Kernel<1, float>::Cutoffs;
+    using Slopes = Kernel<1, float>::Slopes;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    //numRampSamples > 0 glides to the new cutoffs over that many samples, see CrossoverKernel
+    void setCutoffFrequencies(const Cutoffs& cutoffs, int numRampSamples = 0);
+    void setSlopes(const Slopes& slopes);
+
+    //bands must hold at least as many channels and samples as input, for float and double
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& input, const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands);
+private:
+    //input channels [firstChannel, firstChannel + numChannels) through kernel, numChannels <= NumChannels
+    template<size_t NumChannels, typename SampleType>
+    void processChannels(Kernel<NumChannels, SampleType>& kernel, const juce::dsp::AudioBlock<SampleType>& input,
+                         const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands, size_t firstChannel, size_t numChannels);
+
+    template<typename Function>
+    void forEachKernel(Function&& function)
+    {
+        std::apply([&](auto&... kernel) { (function(kernel), ...); }, kernels);
+        std::apply([&](auto&... wide) { ([&] { for ( auto& kernel : wide ) function(kernel); }(), ...); }, wideKernels);
+    }
+
+    std::tuple<Kernel<1, float>, Kernel<2, float>, Kernel<1, double>, Kernel<2, double>> kernels;
+    std::tuple<WideKernels<float>, WideKernels<double>> wideKernels;
+
+    //shared with every other instance at this rate, set by prepare()
+    std::shared_ptr<const CrossoverCoefficientTable> table;
+    Cutoffs cutoffFrequencies = Params::GetDefaultCrossoverFrequencies<NumBands>();
+};
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    CrossoverCoefficientTable.cpp
+    Created: 17 Oct 2026 7:41:09pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "CrossoverCoefficientTable.h"
+#include "FastMath.h"
+
+std::shared_ptr<const CrossoverCoefficientTable> CrossoverCoefficientTable::getShared(double sampleRate)
+{
+    static std::mutex mutex;
+    static std::map<double, std::weak_ptr<const CrossoverCoefficientTable>> tables;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    //drops the tables of rates nobody runs at anymore
+    for ( auto it = tables.begin(); it != tables.end(); )
+        it = it->second.expired() ? tables.erase(it) : std::next(it);
+
+    if ( auto table = tables[sampleRate].lock() )
+        return table;
+
+    auto table = std::make_shared<const CrossoverCoefficientTable>(sampleRate);
+    tables[sampleRate] = table;
+    return table;
+}
+
+CrossoverCoefficientTable::CrossoverCoefficientTable(double newSampleRate)
+    : sampleRate(newSampleRate),
+      maxFrequency(static_cast<float>(0.49 * newSampleRate)),
+      firstIndex(FastMath::floatToBits(MinFrequency) >> CellShift)
+{
+    jassert( maxFrequency > MinFrequency );
+    jassert( getGridFrequency(firstIndex) == MinFrequency );
+
+    //the cell of maxFrequency needs its upper end too
+    auto lastIndex = (FastMath::floatToBits(maxFrequency) >> CellShift) + 1;
+
+    points.resize(static_cast<size_t>(lastIndex - firstIndex + 1));
+    for ( size_t i = 0; i < points.size(); ++i )
+    {
+        auto frequency = static_cast<double>(getGridFrequency(firstIndex + static_cast<int32_t>(i)));
+        auto g = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+        points[i] = { g, juce::MathConstants<double>::pi / sampleRate * (1.0 + g * g) };
+    }
+}
+
+float CrossoverCoefficientTable::getGridFrequency(int32_t index)
+{
+    return FastMath::bitsToFloat(index << CellShift);
+}
+
+double CrossoverCoefficientTable::getG(float cutoff) const
+{
+    auto bits = FastMath::floatToBits(juce::jlimit(MinFrequency, maxFrequency, cutoff));
+    auto index = bits >> CellShift;
+
+    const auto& start = points[static_cast<size_t>(index - firstIndex)];
+    const auto& end = points[static_cast<size_t>(index - firstIndex) + 1];
+
+    //the position in the cell is exact, it is the mantissa bits below the grid
+    auto t = static_cast<double>(bits & CellMask) / static_cast<double>(1 << CellShift);
+    auto width = static_cast<double>(getGridFrequency(index + 1)) - static_cast<double>(getGridFrequency(index));
+
+    auto t2 = t * t;
+    auto t3 = t2 * t;
+
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * start.g + (t3 - 2.0 * t2 + t) * width * start.slope
+         + (3.0 * t2 - 2.0 * t3) * end.g + (t3 - t2) * width * end.slope;
+}
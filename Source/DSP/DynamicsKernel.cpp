@@ -0,0 +1,578 @@
+/*
+  ==============================================================================
+
+    DynamicsKernel.cpp
+    Created: 17 Oct 2026 11:20:54am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "DynamicsKernel.h"
+
+void DynamicsKernel::prepare(const juce::dsp::ProcessSpec& spec, size_t numBands, Precision newPrecision)
+{
+    jassert( spec.sampleRate > 0 );
+    jassert( spec.numChannels <= MaxChannels );
+
+    numChannelsPerBand = spec.numChannels;
+    numLaneGroups = (numBands * numChannelsPerBand + NumLanes - 1) / NumLanes;
+    jassert( numLaneGroups <= MaxLaneGroups );
+
+    sampleRate = spec.sampleRate;
+    expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / spec.sampleRate;
+    precision = newPrecision;
+
+    //the groups a layout does not reach hold no look-ahead lines
+    auto maxWindow = lookAheadToSamples(Params::MaxLookAheadMs, sampleRate);
+    auto doubles = precision == juce::AudioProcessor::doublePrecision;
+    for ( size_t group = 0; group < MaxLaneGroups; ++group )
+    {
+        auto& laneGroup = laneGroups[group];
+        if ( group < numLaneGroups )
+        {
+            laneGroup.lookAhead.prepare(doubles ? 0 : maxWindow);
+            laneGroup.doubleLookAhead.prepare(doubles ? maxWindow : 0);
+        }
+        else
+        {
+            laneGroup.lookAhead.release();
+            laneGroup.doubleLookAhead.release();
+        }
+    }
+
+    maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+    maxLinkedGroups = numChannelsPerBand / 2;
+    detectorStorage.assign(numBands * maxLinkedGroups * maxBlockSize, 0.f);
+    gainStorage.assign(numBands * maxLinkedGroups * maxBlockSize, 1.f);
+    links.setGroups(linkGroups, numChannelsPerBand);
+
+    bandSettings.resize(numBands);
+    updateLaneMap();
+    for ( size_t band = 0; band < numBands; ++band )
+        updateLanes(band);
+
+    reset();
+}
+
+void DynamicsKernel::reset()
+{
+    for ( auto& group : laneGroups )
+    {
+        group.lanes.reset();
+        group.lookAhead.reset();
+        group.doubleLookAhead.reset();
+        group.meters.reset();
+    }
+}
+
+void DynamicsKernel::release()
+{
+    for ( auto& group : laneGroups )
+    {
+        group.lookAhead.release();
+        group.doubleLookAhead.release();
+    }
+
+    std::vector<float>().swap(detectorStorage);
+    std::vector<float>().swap(gainStorage);
+}
+
+size_t DynamicsKernel::getAllocatedBytes() const
+{
+    auto numBytes = (detectorStorage.capacity() + gainStorage.capacity()) * sizeof(float);
+    for ( const auto& group : laneGroups )
+        numBytes += group.lookAhead.getAllocatedBytes() + group.doubleLookAhead.getAllocatedBytes();
+
+    return numBytes;
+}
+
+void DynamicsKernel::setBandSettings(size_t band, const CompressorSettings& settings)
+{
+    jassert( band < bandSettings.size() );
+
+    bandSettings[band] = settings;
+    updateLanes(band);
+}
+
+void DynamicsKernel::setLinkGroups(const ChannelLinks::Groups& groups)
+{
+    std::array<uint32_t, MaxChannels> oldMembers {};
+    for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+        oldMembers[ch] = links.getMembers(ch);
+
+    auto oldMap = laneMap;
+
+    linkGroups = groups;
+    links.setGroups(linkGroups, numChannelsPerBand);
+
+    if ( updateLaneMap() )
+    {
+        moveLanes(oldMap);
+
+        for ( size_t band = 0; band < bandSettings.size(); ++band )
+            updateLanes(band);
+    }
+
+    //a channel that joined or left a group detects something else from here on,
+    //its audio keeps coming out of the delay line
+    for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+    {
+        if ( links.getMembers(ch) == oldMembers[ch] )
+            continue;
+
+        for ( size_t band = 0; band < bandSettings.size(); ++band )
+        {
+            auto lane = getLane(band, ch);
+            auto& group = laneGroups[lane / NumLanes];
+
+            group.lanes.resetLane(lane % NumLanes);
+            group.lookAhead.clearPeaks(lane % NumLanes);
+            group.doubleLookAhead.clearPeaks(lane % NumLanes);
+        }
+    }
+
+    if ( links.sharesGain() )
+        syncFollowers();
+}
+
+void DynamicsKernel::setLinkSettings(const LinkSettings& settings)
+{
+    auto wasSharingGains = links.sharesGain();
+    links.setSettings(settings);
+
+    //followers that computed their own gain pick up their leader's, the ones that shared it were not updated meanwhile
+    if ( links.sharesGain() != wasSharingGains )
+        syncFollowers();
+}
+
+void DynamicsKernel::setControlInterval(int interval)
+{
+    auto newInterval = static_cast<size_t>(juce::jlimit(1, MaxControlInterval, interval));
+    if ( newInterval == controlInterval )
+        return;
+
+    controlInterval = newInterval;
+    for ( auto& group : laneGroups )
+        group.lanes.syncControlGains();
+}
+
+BandLevels DynamicsKernel::getLevels(size_t band) const
+{
+    jassert( band < bandSettings.size() );
+
+    //a band of a wide layout can spread over lane groups, their RMS levels count by their channels
+    BandLevels levels;
+    size_t numMetered = 0;
+
+    for ( size_t group = 0; group < numLaneGroups; ++group )
+    {
+        std::array<size_t, NumLanes> groupLanes {};
+        size_t numGroupLanes = 0;
+        for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+        {
+            auto lane = getLane(band, ch);
+            if ( lane / NumLanes == group )
+                groupLanes[numGroupLanes++] = lane % NumLanes;
+        }
+
+        if ( numGroupLanes == 0 )
+            continue;
+
+        auto groupLevels = laneGroups[group].meters.getLevels(groupLanes.data(), numGroupLanes);
+        levels = mergeBandLevels(levels, numMetered, groupLevels, numGroupLanes);
+        numMetered += numGroupLanes;
+    }
+
+    return levels;
+}
+
+void DynamicsKernel::resetLevels()
+{
+    for ( auto& group : laneGroups )
+        group.meters.reset();
+}
+
+bool DynamicsKernel::updateLaneMap()
+{
+    std::array<bool, MaxChannels> following {};
+    size_t numFollowers = 0;
+    for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+    {
+        following[ch] = links.isFollower(ch);
+        numFollowers += following[ch] ? 1 : 0;
+    }
+
+    auto numLeaders = numChannelsPerBand - numFollowers;
+    auto numBands = bandSettings.size();
+    auto oldMap = laneMap;
+
+    for ( size_t band = 0; band < numBands; ++band )
+    {
+        size_t leader = 0;
+        size_t follower = 0;
+        for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+        {
+            laneMap[band][ch] = following[ch] ? numBands * numLeaders + band * numFollowers + follower++
+                                              : band * numLeaders + leader++;
+        }
+    }
+
+    firstFollowerGroup = (numBands * numLeaders + NumLanes - 1) / NumLanes;
+
+    return laneMap != oldMap;
+}
+
+void DynamicsKernel::moveLanes(const std::array<std::array<size_t, MaxChannels>, Params::NumBands>& oldMap)
+{
+    //where the state now at each lane has to go, a permutation of the lanes in use
+    std::array<size_t, MaxLaneGroups * NumLanes> destinations;
+    for ( size_t lane = 0; lane < destinations.size(); ++lane )
+        destinations[lane] = lane;
+
+    auto numBands = bandSettings.size();
+    for ( size_t band = 0; band < numBands; ++band )
+    {
+        for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+            destinations[oldMap[band][ch]] = laneMap[band][ch];
+    }
+
+    //follows each cycle of the permutation with swaps, so nothing needs a spare lane
+    for ( size_t lane = 0; lane < numBands * numChannelsPerBand; ++lane )
+    {
+        while ( destinations[lane] != lane )
+        {
+            auto target = destinations[lane];
+            auto& from = laneGroups[lane / NumLanes];
+            auto& to = laneGroups[target / NumLanes];
+
+            from.lanes.swapLane(lane % NumLanes, to.lanes, target % NumLanes);
+            from.lookAhead.swapLane(lane % NumLanes, to.lookAhead, target % NumLanes);
+            from.doubleLookAhead.swapLane(lane % NumLanes, to.doubleLookAhead, target % NumLanes);
+
+            std::swap(destinations[lane], destinations[target]);
+        }
+    }
+}
+
+void DynamicsKernel::syncFollowers()
+{
+    for ( size_t band = 0; band < bandSettings.size(); ++band )
+    {
+        for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+        {
+            if ( ! links.isFollower(ch) )
+                continue;
+
+            auto leader = getLane(band, links.getLeader(static_cast<size_t>(links.getGroup(ch))));
+            auto follower = getLane(band, ch);
+            laneGroups[follower / NumLanes].lanes.copyLaneState(follower % NumLanes, laneGroups[leader / NumLanes].lanes, leader % NumLanes);
+        }
+    }
+}
+
+void DynamicsKernel::updateLanes(size_t band)
+{
+    const auto& settings = bandSettings[band];
+    auto window = lookAheadToSamples(settings.lookAhead, sampleRate);
+
+    for ( size_t ch = 0; ch < numChannelsPerBand; ++ch )
+    {
+        auto lane = getLane(band, ch);
+        auto& group = laneGroups[lane / NumLanes];
+
+        group.lanes.setLane(lane % NumLanes, settings, expFactor);
+        group.lookAhead.setWindow(lane % NumLanes, window);
+        group.doubleLookAhead.setWindow(lane % NumLanes, window);
+    }
+}
+
+template<typename SampleType>
+void DynamicsKernel::process(LaneGroup& group, const LaneList<SampleType>& list, size_t numSamples)
+{
+    using Frame = CompressorLanes<NumLanes>::Frame;
+    using AudioFrame = typename LookAheadLanes<NumLanes, SampleType>::AudioFrame;
+
+    const auto* laneIndices = list.indices.data();
+    const auto* lanePointers = list.pointers.data();
+    auto numLanes = list.numLanes;
+    auto numLiveLanes = list.numLiveLanes;
+
+    jassert( numLiveLanes <= numLanes && numLanes <= NumLanes );
+
+    //the whole lane state is copied to the stack so it can stay in registers
+    auto state = group.lanes;
+    auto levelMeters = group.meters;
+
+    //the look-ahead lines of this precision
+    auto& delay = group.getLookAhead<SampleType>();
+    auto lookingAhead = delay.isActive();
+
+    //linked lanes detect their group's detector, the others their own samples
+    std::array<size_t, NumLanes> linkedLanes {};
+    std::array<const float*, NumLanes> linkedDetectors {};
+    size_t numLinkedLanes = 0;
+
+    //the leaders whose followers apply their gains elsewhere
+    std::array<size_t, NumLanes> recordingLanes {};
+    std::array<float*, NumLanes> recordedGains {};
+    size_t numRecordingLanes = 0;
+
+    for ( size_t lane = 0; lane < numLanes; ++lane )
+    {
+        if ( list.detectors[lane] != nullptr )
+        {
+            linkedLanes[numLinkedLanes] = laneIndices[lane];
+            linkedDetectors[numLinkedLanes] = list.detectors[lane];
+            ++numLinkedLanes;
+        }
+
+        if ( list.recordedGains[lane] != nullptr )
+        {
+            recordingLanes[numRecordingLanes] = laneIndices[lane];
+            recordedGains[numRecordingLanes] = list.recordedGains[lane];
+            ++numRecordingLanes;
+        }
+    }
+
+    auto fullyLinked = links.isFullyLinked();
+    auto linkAmount = links.getAmount();
+
+    alignas(32) AudioFrame frame {};
+    alignas(32) AudioFrame input {};
+    alignas(32) Frame level {};
+    alignas(32) Frame gain {};
+
+    auto readFrame = [&](size_t i)
+    {
+        for ( size_t lane = 0; lane < numLanes; ++lane )
+            frame[laneIndices[lane]] = lanePointers[lane][i];
+    };
+
+    auto writeFrame = [&](size_t i)
+    {
+        for ( size_t lane = 0; lane < numLiveLanes; ++lane )
+            lanePointers[lane][i] = frame[laneIndices[lane]];
+    };
+
+    //what the detectors see of sample i, before any look-ahead
+    auto detect = [&](size_t i, Frame& level)
+    {
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+            level[lane] = static_cast<float>(std::abs(frame[lane]));
+
+        for ( size_t lane = 0; lane < numLinkedLanes; ++lane )
+        {
+            auto& laneLevel = level[linkedLanes[lane]];
+            laneLevel = fullyLinked ? linkedDetectors[lane][i] : ChannelLinks::getLinkedLevel(laneLevel, linkedDetectors[lane][i], linkAmount);
+        }
+    };
+
+    auto recordGains = [&](size_t i, const Frame& applied)
+    {
+        for ( size_t lane = 0; lane < numRecordingLanes; ++lane )
+            recordedGains[lane][i] = applied[recordingLanes[lane]];
+    };
+
+    //no live lane can leave unity gain: only the look-ahead and the envelopes run, and without
+    //look-ahead the samples are not even written back, they are the output already
+    auto followSegment = [&](size_t start, size_t length)
+    {
+        alignas(32) Frame unity;
+        unity.fill(1.f);
+
+        for ( size_t i = start; i < start + length; ++i )
+        {
+            readFrame(i);
+            input = frame;
+            detect(i, level);
+
+            if ( lookingAhead )
+            {
+                delay.processFrame(frame, level);
+                writeFrame(i);
+            }
+
+            state.updateDetectors(level);
+            levelMeters.add(input, frame, unity);
+            recordGains(i, unity);
+        }
+
+        if ( controlInterval > 1 )
+            state.syncControlGains();
+    };
+
+    auto compressSegmentAtControlRate = [&](size_t start, size_t length)
+    {
+        alignas(32) std::array<AudioFrame, MaxControlInterval> frames {};
+        alignas(32) std::array<Frame, MaxControlInterval> levels {};
+        alignas(32) std::array<AudioFrame, MaxControlInterval> inputs {};
+        alignas(32) std::array<Frame, MaxControlInterval> gains {};
+
+        for ( auto first = start; first < start + length; first += controlInterval )
+        {
+            auto numFrames = juce::jmin(controlInterval, start + length - first);
+
+            for ( size_t i = 0; i < numFrames; ++i )
+            {
+                readFrame(first + i);
+                inputs[i] = frame;
+                detect(first + i, levels[i]);
+
+                if ( lookingAhead )
+                    delay.processFrame(frame, levels[i]);
+
+                frames[i] = frame;
+            }
+
+            state.processFrames(frames.data(), levels.data(), gains.data(), numFrames);
+
+            for ( size_t i = 0; i < numFrames; ++i )
+            {
+                levelMeters.add(inputs[i], frames[i], gains[i]);
+                recordGains(first + i, gains[i]);
+
+                frame = frames[i];
+                writeFrame(first + i);
+            }
+        }
+    };
+
+    auto compressSegment = [&](size_t start, size_t length)
+    {
+        //the look-ahead loop is kept apart so the common case stays fully vectorized
+        if ( lookingAhead )
+        {
+            for ( size_t i = start; i < start + length; ++i )
+            {
+                readFrame(i);
+                input = frame;
+                detect(i, level);
+                delay.processFrame(frame, level);
+                state.processFrame(frame, level, gain);
+                levelMeters.add(input, frame, gain);
+                recordGains(i, gain);
+                writeFrame(i);
+            }
+
+            return;
+        }
+
+        for ( size_t i = start; i < start + length; ++i )
+        {
+            readFrame(i);
+            input = frame;
+            detect(i, level);
+            state.processFrame(frame, level, gain);
+            levelMeters.add(input, frame, gain);
+            recordGains(i, gain);
+            writeFrame(i);
+        }
+    };
+
+    //segments are whole control intervals, so the gain ramps fall where they would without the fast path
+    auto segmentLength = controlInterval * ((QuietSegmentLength + controlInterval - 1) / controlInterval);
+
+    std::array<size_t, NumLanes> liveLanes {};
+    for ( size_t lane = 0; lane < numLiveLanes; ++lane )
+        liveLanes[lane] = laneIndices[lane];
+
+    for ( size_t start = 0; start < numSamples; start += segmentLength )
+    {
+        auto length = juce::jmin(segmentLength, numSamples - start);
+
+        //the envelope never rises above the larger of where it is and what the detector sees, which
+        //is at most the loudest sample of the segment or the loudest one still in the look-ahead window
+        //(a partly linked lane sees something between its own samples and its detector)
+        alignas(32) Frame peak {};
+        for ( size_t lane = 0; lane < numLiveLanes; ++lane )
+        {
+            auto lanePeak = delay.getWindowPeak(laneIndices[lane]);
+            if ( const auto* detector = list.detectors[lane] )
+            {
+                for ( size_t i = start; i < start + length; ++i )
+                    lanePeak = FastMath::maxNonNegative(lanePeak, detector[i]);
+            }
+
+            if ( list.detectors[lane] == nullptr || ! fullyLinked )
+            {
+                const auto* samples = lanePointers[lane] + start;
+                for ( size_t i = 0; i < length; ++i )
+                    lanePeak = FastMath::maxNonNegative(lanePeak, static_cast<float>(std::abs(samples[i])));
+            }
+
+            peak[laneIndices[lane]] = lanePeak;
+        }
+
+        if ( state.staysAtUnity(peak, liveLanes.data(), numLiveLanes, controlInterval > 1) )
+            followSegment(start, length);
+        else if ( controlInterval > 1 )
+            compressSegmentAtControlRate(start, length);
+        else
+            compressSegment(start, length);
+    }
+
+    levelMeters.endBlock(numSamples);
+    group.lanes = state;
+    group.meters = levelMeters;
+}
+
+template<typename SampleType>
+void DynamicsKernel::applySharedGains(LaneGroup& group, const LaneList<SampleType>& list, size_t numSamples)
+{
+    using Frame = CompressorLanes<NumLanes>::Frame;
+    using AudioFrame = typename LookAheadLanes<NumLanes, SampleType>::AudioFrame;
+
+    const auto* laneIndices = list.indices.data();
+    const auto* lanePointers = list.pointers.data();
+    auto numLanes = list.numLanes;
+    auto numLiveLanes = list.numLiveLanes;
+
+    jassert( numLiveLanes <= numLanes && numLanes <= NumLanes );
+
+    auto levelMeters = group.meters;
+    auto& delay = group.getLookAhead<SampleType>();
+    auto lookingAhead = delay.isActive();
+
+    alignas(32) AudioFrame frame {};
+    alignas(32) AudioFrame input {};
+    alignas(32) Frame level {};
+    alignas(32) Frame gain;
+    gain.fill(1.f);
+
+    for ( size_t i = 0; i < numSamples; ++i )
+    {
+        for ( size_t lane = 0; lane < numLanes; ++lane )
+            frame[laneIndices[lane]] = lanePointers[lane][i];
+
+        input = frame;
+
+        //the windows keep following the detector, for when the followers compute their own gains again
+        if ( lookingAhead )
+        {
+            for ( size_t lane = 0; lane < numLanes; ++lane )
+                level[laneIndices[lane]] = list.detectors[lane][i];
+
+            delay.processFrame(frame, level);
+        }
+
+        for ( size_t lane = 0; lane < numLanes; ++lane )
+            gain[laneIndices[lane]] = list.sharedGains[lane][i];
+
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+            frame[lane] *= gain[lane];
+
+        levelMeters.add(input, frame, gain);
+
+        for ( size_t lane = 0; lane < numLiveLanes; ++lane )
+            lanePointers[lane][i] = frame[laneIndices[lane]];
+    }
+
+    levelMeters.endBlock(numSamples);
+    group.meters = levelMeters;
+}
+
+template void DynamicsKernel::process<float>(LaneGroup&, const LaneList<float>&, size_t);
+template void DynamicsKernel::process<double>(LaneGroup&, const LaneList<double>&, size_t);
+template void DynamicsKernel::applySharedGains<float>(LaneGroup&, const LaneList<float>&, size_t);
+template void DynamicsKernel::applySharedGains<double>(LaneGroup&, const LaneList<double>&, size_t);
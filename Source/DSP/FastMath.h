@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    FastMath.h
+    Created: 17 Oct 2026 11:20:54am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ Branch free log2/exp2 for the inner loops of the dynamics code.
+ Written with plain float/int operations so loops over lanes auto-vectorize,
+ which std::log2/std::exp2 (library calls) prevent.
+ Both are the Cephes single precision polynomials, accurate to a couple of ulp
+ over the range the gain computer uses, and exact at log2(1) == 0 and exp2(0) == 1.
+ */
+namespace FastMath
+{
+inline float bitsToFloat(int32_t bits)
+{
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline int32_t floatToBits(float f)
+{
+    int32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+//max() for non-negative floats done on their bit patterns, which sort the same way.
+//Unlike a float compare this cannot trap, so GCC is willing to vectorize loops using it.
+inline float maxNonNegative(float a, float b)
+{
+    return bitsToFloat(juce::jmax(floatToBits(a), floatToBits(b)));
+}
+
+inline float minNonNegative(float a, float b)
+{
+    return bitsToFloat(juce::jmin(floatToBits(a), floatToBits(b)));
+}
+
+//x must be positive and finite
+inline float log2(float x)
+{
+    //splits x into 2^exponent * mantissa with the mantissa in [sqrt(0.5), sqrt(2)),
+    //using integer arithmetic only so there is nothing for the vectorizer to branch on
+    constexpr int32_t sqrtHalfBits = 0x3f3504f3;
+    auto offsetBits = floatToBits(x) - sqrtHalfBits;
+    auto exponent = static_cast<float>(offsetBits >> 23);
+    auto mantissa = bitsToFloat((offsetBits & 0x007fffff) + sqrtHalfBits);
+
+    auto f = mantissa - 1.f;
+    auto z = f * f;
+
+    auto y = 7.0376836292e-2f;
+    y = y * f - 1.1514610310e-1f;
+    y = y * f + 1.1676998740e-1f;
+    y = y * f - 1.2420140846e-1f;
+    y = y * f + 1.4249322787e-1f;
+    y = y * f - 1.6668057665e-1f;
+    y = y * f + 2.0000714765e-1f;
+    y = y * f - 2.4999993993e-1f;
+    y = y * f + 3.3333331174e-1f;
+    y = y * f * z - 0.5f * z;
+
+    auto ln = f + y;
+    return ln * 1.44269504088896341f + exponent;
+}
+
+//x must be within [-126, 126]
+inline float exp2(float x)
+{
+    //round to nearest by pushing the fraction out of the mantissa, the integer ends up in the low bits
+    constexpr float roundingOffset = 12582912.f; // 1.5 * 2^23
+    auto shifted = x + roundingOffset;
+    auto integerPart = floatToBits(shifted) - floatToBits(roundingOffset);
+    auto f = x - (shifted - roundingOffset);
+
+    auto p = 1.535336188319500e-4f;
+    p = p * f + 1.339887440266574e-3f;
+    p = p * f + 9.618437357674640e-3f;
+    p = p * f + 5.550332471162809e-2f;
+    p = p * f + 2.402264791363012e-1f;
+    p = p * f + 6.931472028550421e-1f;
+    p = p * f + 1.f;
+
+    return bitsToFloat(floatToBits(p) + integerPart * (1 << 23));
+}
+}
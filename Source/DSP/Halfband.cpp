@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    Halfband.cpp
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "Halfband.h"
+
+namespace
+{
+double besselI0(double x)
+{
+    //the power series, its terms fall off fast enough for the window's beta
+    auto sum = 1.0;
+    auto term = 1.0;
+    for ( int k = 1; term > 1.0e-17 * sum; ++k )
+    {
+        term *= (0.5 * x / k) * (0.5 * x / k);
+        sum += term;
+    }
+
+    return sum;
+}
+
+//the side taps of a half-band of numTaps taps, each sinc tap times window(n), n = 0 ... numTaps - 1
+template<typename Window>
+Halfband makeHalfband(int numTaps, double passband, Window&& window)
+{
+    Halfband filter;
+    filter.numTaps = numTaps;
+    filter.numBranchTaps = (numTaps + 1) / 2;
+    filter.passband = passband;
+
+    jassert( filter.numBranchTaps <= Halfband::MaxBranchTaps );
+    jassert( (numTaps - 3) % 4 == 0 );
+
+    //normalised so the side taps plus the center tap have unity gain at DC
+    std::array<double, Halfband::MaxBranchTaps> taps {};
+    auto sum = 0.0;
+    for ( int i = 0; i < filter.numBranchTaps; ++i )
+    {
+        auto n = 2 * i;
+        auto x = 0.5 * (n - filter.getCenterDelay());
+
+        taps[static_cast<size_t>(i)] = 0.5 * std::sin(juce::MathConstants<double>::pi * x) / (juce::MathConstants<double>::pi * x) * window(n);
+        sum += taps[static_cast<size_t>(i)];
+    }
+
+    for ( size_t i = 0; i < static_cast<size_t>(filter.numBranchTaps); ++i )
+        filter.coefficients[i] = static_cast<float>(taps[i] * 0.5 / sum);
+
+    return filter;
+}
+}
+
+const Halfband& Halfband::get(Design design)
+{
+    static const Halfband shortFilter = makeHalfband(31, 0.15, [](int n)
+    {
+        auto phase = 2.0 * juce::MathConstants<double>::pi * n / 30.0;
+        return 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+    });
+
+    //beta for 80 dB, which 111 taps over a transition of 0.045 get within 5 dB of
+    static const Halfband steepFilter = makeHalfband(MaxTaps, 0.2275, [](int n)
+    {
+        constexpr double beta = 7.857;
+        auto position = 2.0 * n / (MaxTaps - 1) - 1.0;
+        return besselI0(beta * std::sqrt(1.0 - position * position)) / besselI0(beta);
+    });
+
+    return design == Design::Steep ? steepFilter : shortFilter;
+}
+
+//==============================================================================
+size_t HalfbandWorkspace::getArenaSize(size_t maxSamples)
+{
+    return 2 * BufferArena::getSliceSize(Halfband::MaxSideTapHistory + maxSamples);
+}
+
+void HalfbandWorkspace::prepare(BufferArena& arena, size_t newMaxSamples)
+{
+    maxSamples = newMaxSamples;
+    first = arena.allocate(Halfband::MaxSideTapHistory + maxSamples);
+    second = arena.allocate(Halfband::MaxSideTapHistory + maxSamples);
+}
+
+//==============================================================================
+void HalfbandDecimator::prepare(HalfbandWorkspace& newWorkspace, Halfband::Design design)
+{
+    workspace = &newWorkspace;
+    filter = &Halfband::get(design);
+
+    reset();
+}
+
+void HalfbandDecimator::reset()
+{
+    oddHistory.fill(0.f);
+    evenHistory.fill(0.f);
+
+    pendingInput = 0.f;
+    hasPendingInput = false;
+}
+
+size_t HalfbandDecimator::process(const float* in, size_t numSamples, float* out)
+{
+    //what the filter's taps reach back to, the end of each history array
+    auto sideTapHistory = static_cast<size_t>(filter->numBranchTaps - 1);
+    auto centerTapHistory = static_cast<size_t>(filter->getCenterDelay() - 1) / 2;
+
+    //the branches go behind their history, as one contiguous array each
+    auto* odd = workspace->first + Halfband::MaxSideTapHistory;
+    auto* even = workspace->second + Halfband::MaxSideTapHistory;
+    std::copy(oddHistory.end() - sideTapHistory, oddHistory.end(), odd - sideTapHistory);
+    std::copy(evenHistory.end() - centerTapHistory, evenHistory.end(), even - centerTapHistory);
+
+    //split into the polyphase branches, an output is due with every odd input
+    size_t numOut = 0;
+    size_t i = 0;
+
+    if ( hasPendingInput && numSamples > 0 )
+    {
+        even[0] = pendingInput;
+        odd[0] = in[0];
+        numOut = 1;
+        i = 1;
+        hasPendingInput = false;
+    }
+
+    for ( ; i + 1 < numSamples; i += 2 )
+    {
+        even[numOut] = in[i];
+        odd[numOut] = in[i + 1];
+        ++numOut;
+    }
+
+    if ( i < numSamples )
+    {
+        pendingInput = in[i];
+        hasPendingInput = true;
+    }
+
+    jassert( numOut <= workspace->maxSamples );
+
+    if ( numOut == 0 )
+        return 0;
+
+    const auto& c = filter->coefficients;
+    const auto* center = even - centerTapHistory;
+
+    for ( size_t m = 0; m < numOut; ++m )
+        out[m] = 0.5f * center[m];
+
+    for ( size_t k = 0; k <= sideTapHistory; ++k )
+    {
+        const auto* x = odd - k;
+        auto tap = c[k];
+
+        for ( size_t m = 0; m < numOut; ++m )
+            out[m] += tap * x[m];
+    }
+
+    std::copy(odd + numOut - sideTapHistory, odd + numOut, oddHistory.end() - sideTapHistory);
+    std::copy(even + numOut - centerTapHistory, even + numOut, evenHistory.end() - centerTapHistory);
+
+    return numOut;
+}
+
+//==============================================================================
+void HalfbandInterpolator::prepare(HalfbandWorkspace& newWorkspace, Halfband::Design design)
+{
+    workspace = &newWorkspace;
+    filter = &Halfband::get(design);
+
+    reset();
+}
+
+void HalfbandInterpolator::reset()
+{
+    history.fill(0.f);
+}
+
+void HalfbandInterpolator::process(const float* in, size_t numSamples, float* out)
+{
+    jassert( numSamples <= workspace->maxSamples );
+
+    if ( numSamples == 0 )
+        return;
+
+    auto sideTapHistory = static_cast<size_t>(filter->numBranchTaps - 1);
+    auto centerTapHistory = static_cast<size_t>(filter->getCenterDelay() - 1) / 2;
+
+    auto* x = workspace->first + Halfband::MaxSideTapHistory;
+    auto* evenOutputs = workspace->second;
+    std::copy(history.end() - sideTapHistory, history.end(), x - sideTapHistory);
+    std::copy(in, in + numSamples, x);
+
+    //the zeros stuffed in between never meet a side tap, so the even outputs are a plain FIR
+    //over the inputs and the odd ones are the center tap (0.5, times the interpolation gain of 2)
+    const auto& c = filter->coefficients;
+
+    for ( size_t m = 0; m < numSamples; ++m )
+        evenOutputs[m] = c[0] * x[m];
+
+    for ( size_t k = 1; k <= sideTapHistory; ++k )
+    {
+        const auto* delayed = x - k;
+        auto tap = c[k];
+
+        for ( size_t m = 0; m < numSamples; ++m )
+            evenOutputs[m] += tap * delayed[m];
+    }
+
+    const auto* center = x - centerTapHistory;
+    for ( size_t m = 0; m < numSamples; ++m )
+    {
+        out[2 * m] = 2.f * evenOutputs[m];
+        out[2 * m + 1] = center[m];
+    }
+
+    std::copy(x + numSamples - sideTapHistory, x + numSamples, history.end() - sideTapHistory);
+}
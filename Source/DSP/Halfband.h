@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    Halfband.h
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "BufferArena.h"
+
+/**
+ Linear phase half-band FIRs (windowed sinc), used as polyphase decimators/interpolators by 2.
+ Every other tap apart from the center one (0.5) is zero, so each output needs the side taps
+ of one polyphase branch only. There are two designs, in fractions of the rate the filter
+ runs at (the higher of its two):
+
+     Short   31 taps, Blackman      passband to 0.15, stopband from 0.35, ~74 dB down
+     Steep  111 taps, Kaiser 7.86   passband to 0.2275 (within 0.002 dB), stopband from 0.2725, ~75 dB down
+
+ Steep passes everything up to 0.455 of the lower rate, 20 kHz at 44.1 kHz, but costs 3.5
+ times as much, so it only runs where the lower rate is the one the band is heard at.
+
+ Both resamplers work on whole blocks: the taps form the outer loop and the samples the
+ inner one, so the multiply-adds run on contiguous arrays and auto-vectorize.
+ */
+struct Halfband
+{
+    enum class Design
+    {
+        Short,
+        Steep,
+    };
+
+    static constexpr int MaxTaps = 111;
+    static constexpr int MaxBranchTaps = (MaxTaps + 1) / 2;
+
+    //what the decimator keeps of each polyphase branch, for the longest design
+    static constexpr int MaxSideTapHistory = MaxBranchTaps - 1;
+    static constexpr int MaxCenterTapHistory = (MaxTaps - 3) / 4;
+
+    static const Halfband& get(Design design);
+
+    int numTaps = 0;
+    int numBranchTaps = 0;
+
+    //the side taps h[0], h[2] ... h[numTaps - 1], numBranchTaps of them
+    std::array<float, MaxBranchTaps> coefficients {};
+
+    //where the passband ends, as a fraction of the rate the filter runs at
+    double passband = 0.0;
+
+    //delay of the center tap, in input samples of the decimator and in output samples of the interpolator
+    int getCenterDelay() const { return (numTaps - 1) / 2; }
+
+    /**
+     Delay of a decimate-by-2 followed by an interpolate-by-2 (or the other way round),
+     in samples of the higher rate. The decimator keeps the second sample of every pair,
+     which is one sample earlier than the center tap.
+     */
+    int getRoundTripDelay() const { return 2 * getCenterDelay() - 1; }
+};
+
+/**
+ The block buffers of the resamplers. A process() call only uses them while it runs (the
+ resamplers keep their history themselves), so resamplers that run one after the other
+ can all share one workspace.
+ */
+struct HalfbandWorkspace
+{
+    //blocks of up to maxSamples interpolator inputs or decimator outputs
+    static size_t getArenaSize(size_t maxSamples);
+    void prepare(BufferArena& arena, size_t maxSamples);
+private:
+    friend struct HalfbandDecimator;
+    friend struct HalfbandInterpolator;
+
+    //each with room for the longest history in front of the block
+    float* first = nullptr;
+    float* second = nullptr;
+    size_t maxSamples = 0;
+};
+
+/** Halves the rate, one output for every pair of inputs. Odd block sizes carry the unpaired sample over. */
+struct HalfbandDecimator
+{
+    //keeps a pointer to workspace, which must hold half the longest block plus one
+    void prepare(HalfbandWorkspace& workspace, Halfband::Design design = Halfband::Design::Short);
+    void reset();
+
+    //returns the number of outputs written to out
+    size_t process(const float* in, size_t numSamples, float* out);
+private:
+    //what the taps of the two polyphase branches reach back to
+    std::array<float, Halfband::MaxSideTapHistory> oddHistory {};
+    std::array<float, Halfband::MaxCenterTapHistory> evenHistory {};
+    HalfbandWorkspace* workspace = nullptr;
+    const Halfband* filter = nullptr;
+
+    float pendingInput = 0.f;
+    bool hasPendingInput = false;
+};
+
+/** Doubles the rate, two outputs for every input. */
+struct HalfbandInterpolator
+{
+    //keeps a pointer to workspace, which must hold the longest block
+    void prepare(HalfbandWorkspace& workspace, Halfband::Design design = Halfband::Design::Short);
+    void reset();
+
+    //writes 2 * numSamples outputs
+    void process(const float* in, size_t numSamples, float* out);
+private:
+    std::array<float, Halfband::MaxSideTapHistory> history {};
+    HalfbandWorkspace* workspace = nullptr;
+    const Halfband* filter = nullptr;
+};
@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    LevelMeters.h
+    Created: 17 Oct 2026 8:26:52pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FastMath.h"
+
+/**
+ What one band's compressor did since its levels were last taken: RMS and peak of what went
+ in and came out, and the lowest and highest gain it applied (linear, 1 is no reduction).
+ */
+struct BandLevels
+{
+    float rmsInput = 0.f;
+    float rmsOutput = 0.f;
+    float peakInput = 0.f;
+    float peakOutput = 0.f;
+    float minGain = 1.f;
+    float maxGain = 1.f;
+};
+
+//the levels of numLanes lanes and of numOtherLanes more, as if they had been metered as one (see LevelMeterLanes::getLevels())
+inline BandLevels mergeBandLevels(const BandLevels& levels, size_t numLanes, const BandLevels& other, size_t numOtherLanes)
+{
+    if ( numLanes == 0 )
+        return other;
+
+    auto merged = levels;
+    auto weight = static_cast<float>(numOtherLanes) / static_cast<float>(numLanes + numOtherLanes);
+
+    merged.rmsInput += weight * (other.rmsInput - levels.rmsInput);
+    merged.rmsOutput += weight * (other.rmsOutput - levels.rmsOutput);
+    merged.peakInput = juce::jmax(levels.peakInput, other.peakInput);
+    merged.peakOutput = juce::jmax(levels.peakOutput, other.peakOutput);
+    merged.minGain = juce::jmin(levels.minGain, other.minGain);
+    merged.maxGain = juce::jmax(levels.maxGain, other.maxGain);
+    return merged;
+}
+
+/**
+ Level meters for NumLanes compressor lanes, fed from inside the compressor's sample loop,
+ so metering needs no pass of its own over the band buffers.
+
+ add() is nothing but lane loops of multiply-adds and integer min/max that vectorize
+ alongside the gain computer. The float energy sums only ever cover one process call,
+ endBlock() moves them to double totals that getLevels() reads until reset().
+ */
+template<size_t NumLanes>
+struct LevelMeterLanes
+{
+    using Frame = std::array<float, NumLanes>;
+
+    void reset()
+    {
+        inputEnergy.fill(0.f);
+        outputEnergy.fill(0.f);
+        inputPeak.fill(0.f);
+        outputPeak.fill(0.f);
+        minGain.fill(1.f);
+        maxGain.fill(0.f);
+        inputTotal.fill(0.0);
+        outputTotal.fill(0.0);
+        numTotalSamples = 0;
+    }
+
+    //one sample of every lane: what went into the compressor, what came out and the gain in between
+    //the samples may be double (AudioFrame), the meters always run in float
+    template<typename AudioFrame>
+    forcedinline void add(const AudioFrame& input, const AudioFrame& output, const Frame& gain)
+    {
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+        {
+            auto in = static_cast<float>(input[lane]);
+            auto out = static_cast<float>(output[lane]);
+
+            inputEnergy[lane] += in * in;
+            outputEnergy[lane] += out * out;
+            inputPeak[lane] = FastMath::maxNonNegative(inputPeak[lane], std::abs(in));
+            outputPeak[lane] = FastMath::maxNonNegative(outputPeak[lane], std::abs(out));
+            minGain[lane] = FastMath::minNonNegative(minGain[lane], gain[lane]);
+            maxGain[lane] = FastMath::maxNonNegative(maxGain[lane], gain[lane]);
+        }
+    }
+
+    //the input alone, for lanes that only run their detectors (see CompressorLanes::updateDetectors())
+    template<typename AudioFrame>
+    forcedinline void addInput(const AudioFrame& input)
+    {
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+        {
+            auto in = static_cast<float>(input[lane]);
+
+            inputEnergy[lane] += in * in;
+            inputPeak[lane] = FastMath::maxNonNegative(inputPeak[lane], std::abs(in));
+        }
+    }
+
+    //every lane went through add() or addInput() numSamples times since the last call
+    void endBlock(size_t numSamples)
+    {
+        for ( size_t lane = 0; lane < NumLanes; ++lane )
+        {
+            inputTotal[lane] += inputEnergy[lane];
+            outputTotal[lane] += outputEnergy[lane];
+        }
+
+        inputEnergy.fill(0.f);
+        outputEnergy.fill(0.f);
+        numTotalSamples += numSamples;
+    }
+
+    //lanes[0 .. numLanes) (e.g. the channels of a band) as one meter: the RMS levels are
+    //averaged over the lanes, peaks and gains are the extremes of all of them
+    BandLevels getLevels(const size_t* lanes, size_t numLanes) const
+    {
+        BandLevels levels;
+        if ( numLanes == 0 || numTotalSamples == 0 )
+            return levels;
+
+        levels.minGain = minGain[lanes[0]];
+        levels.maxGain = maxGain[lanes[0]];
+
+        for ( size_t i = 0; i < numLanes; ++i )
+        {
+            auto lane = lanes[i];
+            jassert( lane < NumLanes );
+
+            levels.rmsInput += static_cast<float>(std::sqrt(inputTotal[lane] / static_cast<double>(numTotalSamples)));
+            levels.rmsOutput += static_cast<float>(std::sqrt(outputTotal[lane] / static_cast<double>(numTotalSamples)));
+            levels.peakInput = juce::jmax(levels.peakInput, inputPeak[lane]);
+            levels.peakOutput = juce::jmax(levels.peakOutput, outputPeak[lane]);
+            levels.minGain = juce::jmin(levels.minGain, minGain[lane]);
+            levels.maxGain = juce::jmax(levels.maxGain, maxGain[lane]);
+        }
+
+        levels.rmsInput /= static_cast<float>(numLanes);
+        levels.rmsOutput /= static_cast<float>(numLanes);
+
+        //only inputs were metered, no gain was applied
+        if ( levels.maxGain < levels.minGain )
+            levels.minGain = levels.maxGain = 1.f;
+
+        return levels;
+    }
+private:
+    static constexpr size_t Alignment = NumLanes * sizeof(float);
+
+    alignas(Alignment) Frame inputEnergy {};
+    alignas(Alignment) Frame outputEnergy {};
+    alignas(Alignment) Frame inputPeak {};
+    alignas(Alignment) Frame outputPeak {};
+    alignas(Alignment) Frame minGain {};
+    alignas(Alignment) Frame maxGain {};
+
+    std::array<double, NumLanes> inputTotal {};
+    std::array<double, NumLanes> outputTotal {};
+    size_t numTotalSamples = 0;
+};
@@ -0,0 +1,476 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.cpp
+    Created: 17 Oct 2026 3:12:36pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "LinearPhaseCrossover.h"
+
+LinearPhaseCrossover::LinearPhaseCrossover()
+{
+    for ( auto& cutoff : requestedCutoffs )
+        cutoff.store(0.f);
+}
+
+LinearPhaseCrossover::~LinearPhaseCrossover()
+{
+    builderThread->removeTimeSliceClient(&builder);
+}
+
+void LinearPhaseCrossover::prepare(const juce::dsp::ProcessSpec& spec, const Cutoffs& cutoffs, bool allocate)
+{
+    jassert( spec.numChannels <= MaxChannels );
+
+    //waits for a rebuild that is running, the kernels are about to be reallocated
+    builderThread->removeTimeSliceClient(&builder);
+
+    sampleRate = spec.sampleRate;
+
+    //~4096 taps at 44.1/48 kHz, so the resolution in Hz stays the same at higher rates
+    kernelLength = juce::nextPowerOfTwo(static_cast<int>(sampleRate / 12.0)) - 1;
+    latency = (kernelLength - 1) / 2 + PartitionSize;
+    numPartitions = static_cast<size_t>((kernelLength + PartitionSize - 1) / PartitionSize);
+
+    //a surround bus needs its channels' spectra, a stereo one keeps the rest unallocated
+    numPreparedChannels = spec.numChannels;
+
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+        requestedCutoffs[i].store(cutoffs[i]);
+
+    builtVersion = requestedVersion.load();
+
+    if ( allocate )
+        allocateBuffers(cutoffs);
+    else
+        freeBuffers();
+
+    kernelsRequested.store(allocate);
+
+    builderThread->addTimeSliceClient(&builder);
+}
+
+void LinearPhaseCrossover::allocateBuffers(const Cutoffs& cutoffs)
+{
+    fft = std::make_unique<juce::dsp::FFT>(FFTOrder);
+    builderFFT = std::make_unique<juce::dsp::FFT>(FFTOrder);
+
+    //the JUCE FFT works in place on twice its size
+    fftScratch.assign(4 * PartitionSize, 0.f);
+    builderScratch.assign(4 * PartitionSize, 0.f);
+    accumulator.assign(getSpectrumSize(), 0.f);
+    fadeScratch.assign(NumCrossovers * PartitionSize, 0.f);
+
+    auto centerTap = (kernelLength - 1) / 2;
+    auto drySize = static_cast<size_t>(juce::nextPowerOfTwo(centerTap + 2 * PartitionSize));
+    for ( size_t ch = 0; ch < MaxChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        if ( ch >= numPreparedChannels )
+        {
+            freeChannel(state);
+            continue;
+        }
+
+        state.inputFrame.assign(2 * PartitionSize, 0.f);
+        state.inputSpectra.assign(numPartitions * getSpectrumSize(), 0.f);
+        state.dryDelay.assign(drySize, 0.f);
+
+        for ( auto& frame : state.bandFrames )
+            frame.assign(PartitionSize, 0.f);
+    }
+
+    for ( auto& kernels : kernelSets )
+        kernels.spectra.assign(NumCrossovers * numPartitions * getSpectrumSize(), 0.f);
+
+    //the first kernels are built right here, later changes go through rebuildKernelsIfNeeded()
+    buildKernels(kernelSets[0], cutoffs, *builderFFT, builderScratch);
+    kernelSets[0].cutoffs = cutoffs;
+    kernelSlots.store(packSlots(0, NoKernels));
+
+    framePosition = 0;
+    spectrumPosition = 0;
+    dryPosition = 0;
+
+    ready.store(true, std::memory_order_release);
+}
+
+void LinearPhaseCrossover::reset()
+{
+    //nothing to clear before the buffers are there, and the background thread may be allocating them
+    if ( ! isReady() )
+        return;
+
+    for ( auto& state : channels )
+    {
+        std::fill(state.inputFrame.begin(), state.inputFrame.end(), 0.f);
+        std::fill(state.inputSpectra.begin(), state.inputSpectra.end(), 0.f);
+        std::fill(state.dryDelay.begin(), state.dryDelay.end(), 0.f);
+
+        for ( auto& frame : state.bandFrames )
+            std::fill(frame.begin(), frame.end(), 0.f);
+    }
+
+    framePosition = 0;
+    spectrumPosition = 0;
+    dryPosition = 0;
+}
+
+void LinearPhaseCrossover::requestKernels(const Cutoffs& cutoffs)
+{
+    if ( kernelsRequested.load(std::memory_order_relaxed) )
+        return;
+
+    setCutoffFrequencies(cutoffs);
+    kernelsRequested.store(true, std::memory_order_release);
+}
+
+void LinearPhaseCrossover::release()
+{
+    builderThread->removeTimeSliceClient(&builder);
+
+    freeBuffers();
+    numPreparedChannels = 0;
+    kernelsRequested.store(false);
+}
+
+void LinearPhaseCrossover::freeBuffers()
+{
+    ready.store(false, std::memory_order_release);
+
+    fft.reset();
+    builderFFT.reset();
+
+    auto free = [](std::vector<float>& buffer) { std::vector<float>().swap(buffer); };
+
+    free(fftScratch);
+    free(builderScratch);
+    free(accumulator);
+    free(fadeScratch);
+
+    for ( auto& state : channels )
+        freeChannel(state);
+
+    for ( auto& kernels : kernelSets )
+        free(kernels.spectra);
+}
+
+void LinearPhaseCrossover::freeChannel(ChannelState& state)
+{
+    auto free = [](std::vector<float>& buffer) { std::vector<float>().swap(buffer); };
+
+    free(state.inputFrame);
+    free(state.inputSpectra);
+    free(state.dryDelay);
+
+    for ( auto& frame : state.bandFrames )
+        free(frame);
+}
+
+size_t LinearPhaseCrossover::getAllocatedBytes() const
+{
+    if ( ! isReady() )
+        return 0;
+
+    auto numFloats = fftScratch.capacity() + builderScratch.capacity() + accumulator.capacity() + fadeScratch.capacity();
+
+    for ( const auto& state : channels )
+    {
+        numFloats += state.inputFrame.capacity() + state.inputSpectra.capacity() + state.dryDelay.capacity();
+
+        for ( const auto& frame : state.bandFrames )
+            numFloats += frame.capacity();
+    }
+
+    for ( const auto& kernels : kernelSets )
+        numFloats += kernels.spectra.capacity();
+
+    return numFloats * sizeof(float);
+}
+
+void LinearPhaseCrossover::setCutoffFrequencies(const Cutoffs& cutoffs)
+{
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+        requestedCutoffs[i].store(cutoffs[i], std::memory_order_relaxed);
+
+    requestedVersion.fetch_add(1, std::memory_order_release);
+}
+
+template<typename SampleType>
+void LinearPhaseCrossover::process(const juce::dsp::AudioBlock<SampleType>& input, const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands)
+{
+    auto numChannels = input.getNumChannels();
+    auto numSamples = input.getNumSamples();
+
+    jassert( numChannels <= numPreparedChannels );
+    jassert( isReady() );
+
+    auto dryMask = channels[0].dryDelay.size() - 1;
+
+    size_t done = 0;
+    while ( done < numSamples )
+    {
+        auto length = juce::jmin(numSamples - done, static_cast<size_t>(PartitionSize) - framePosition);
+
+        for ( size_t ch = 0; ch < numChannels; ++ch )
+        {
+            auto& state = channels[ch];
+            const auto* in = input.getChannelPointer(ch) + done;
+
+            std::copy(in, in + length, state.inputFrame.begin() + PartitionSize + static_cast<long>(framePosition));
+
+            for ( size_t i = 0; i < length; ++i )
+                state.dryDelay[(dryPosition + i) & dryMask] = static_cast<float>(in[i]);
+
+            //outputs are one partition behind, they were computed when the last partition was complete
+            for ( size_t band = 0; band < NumBands; ++band )
+            {
+                const auto* frame = state.bandFrames[band].data() + framePosition;
+                std::copy(frame, frame + length, bands[band].getChannelPointer(ch) + done);
+            }
+        }
+
+        framePosition += length;
+        dryPosition = (dryPosition + length) & dryMask;
+        done += length;
+
+        if ( framePosition == static_cast<size_t>(PartitionSize) )
+        {
+            //picks up kernels the background thread finished since the last partition,
+            //the old ones stay reserved as the fading set until this partition is done
+            const KernelSet* fadingOut = nullptr;
+            auto slots = kernelSlots.load(std::memory_order_acquire);
+            if ( getReadySlot(slots) != NoKernels )
+            {
+                auto newSlots = packSlots(getReadySlot(slots), NoKernels, getActiveSlot(slots));
+                if ( kernelSlots.compare_exchange_strong(slots, newSlots, std::memory_order_acq_rel) )
+                {
+                    fadingOut = &kernelSets[static_cast<size_t>(getActiveSlot(slots))];
+                    slots = newSlots;
+                }
+            }
+
+            const auto& kernels = kernelSets[static_cast<size_t>(getActiveSlot(slots))];
+
+            for ( size_t ch = 0; ch < numChannels; ++ch )
+                processPartition(channels[ch], kernels, fadingOut);
+
+            //hands the old set back to the background thread
+            if ( fadingOut != nullptr )
+            {
+                while ( ! kernelSlots.compare_exchange_weak(slots, packSlots(getActiveSlot(slots), getReadySlot(slots)), std::memory_order_acq_rel) )
+                {
+                }
+            }
+
+            spectrumPosition = (spectrumPosition + 1) % numPartitions;
+            framePosition = 0;
+        }
+    }
+}
+
+void LinearPhaseCrossover::processPartition(ChannelState& state, const KernelSet& kernels, const KernelSet* fadingOut)
+{
+    auto numBins = getNumBins();
+    auto spectrumSize = getSpectrumSize();
+
+    //overlap-save: the previous partition followed by the new one
+    std::copy(state.inputFrame.begin(), state.inputFrame.end(), fftScratch.begin());
+    std::fill(fftScratch.begin() + 2 * PartitionSize, fftScratch.end(), 0.f);
+    fft->performRealOnlyForwardTransform(fftScratch.data(), true);
+
+    //spectra are stored as [re... | im...] so the multiply-adds below are plain lane loops
+    auto* spectrum = state.inputSpectra.data() + spectrumPosition * spectrumSize;
+    for ( size_t bin = 0; bin < numBins; ++bin )
+    {
+        spectrum[bin] = fftScratch[2 * bin];
+        spectrum[numBins + bin] = fftScratch[2 * bin + 1];
+    }
+
+    std::copy(state.inputFrame.begin() + PartitionSize, state.inputFrame.end(), state.inputFrame.begin());
+
+    for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+        convolve(state, kernels, crossover, state.bandFrames[crossover].data());
+
+    //the lowpasses are linear in the kernels, so fading them fades every band
+    if ( fadingOut != nullptr )
+    {
+        for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+        {
+            auto* old = fadeScratch.data() + crossover * PartitionSize;
+            convolve(state, *fadingOut, crossover, old);
+
+            auto& frame = state.bandFrames[crossover];
+            for ( size_t i = 0; i < static_cast<size_t>(PartitionSize); ++i )
+            {
+                auto gain = static_cast<float>(i + 1) / static_cast<float>(PartitionSize);
+                frame[i] = old[i] + gain * (frame[i] - old[i]);
+            }
+        }
+    }
+
+    //bandFrames[i] holds LPi for now, turn them into differences from the top down
+    auto dryMask = state.dryDelay.size() - 1;
+    auto dryStart = dryPosition + state.dryDelay.size() - PartitionSize - static_cast<size_t>((kernelLength - 1) / 2);
+
+    auto& lastBand = state.bandFrames[NumBands - 1];
+    const auto& lastLowpass = state.bandFrames[NumCrossovers - 1];
+    for ( size_t i = 0; i < static_cast<size_t>(PartitionSize); ++i )
+        lastBand[i] = state.dryDelay[(dryStart + i) & dryMask] - lastLowpass[i];
+
+    for ( size_t band = NumCrossovers - 1; band > 0; --band )
+    {
+        auto& frame = state.bandFrames[band];
+        const auto& below = state.bandFrames[band - 1];
+        for ( size_t i = 0; i < static_cast<size_t>(PartitionSize); ++i )
+            frame[i] -= below[i];
+    }
+}
+
+void LinearPhaseCrossover::convolve(const ChannelState& state, const KernelSet& kernels, size_t crossover, float* lowpass)
+{
+    auto numBins = getNumBins();
+    auto spectrumSize = getSpectrumSize();
+
+    std::fill(accumulator.begin(), accumulator.end(), 0.f);
+    auto* accRe = accumulator.data();
+    auto* accIm = accumulator.data() + numBins;
+
+    for ( size_t partition = 0; partition < numPartitions; ++partition )
+    {
+        //partition p of the kernel meets the input from p partitions ago
+        auto slot = (spectrumPosition + numPartitions - partition) % numPartitions;
+        const auto* xRe = state.inputSpectra.data() + slot * spectrumSize;
+        const auto* xIm = xRe + numBins;
+        const auto* hRe = kernels.spectra.data() + (crossover * numPartitions + partition) * spectrumSize;
+        const auto* hIm = hRe + numBins;
+
+        for ( size_t bin = 0; bin < numBins; ++bin )
+        {
+            accRe[bin] += xRe[bin] * hRe[bin] - xIm[bin] * hIm[bin];
+            accIm[bin] += xRe[bin] * hIm[bin] + xIm[bin] * hRe[bin];
+        }
+    }
+
+    for ( size_t bin = 0; bin < numBins; ++bin )
+    {
+        fftScratch[2 * bin] = accRe[bin];
+        fftScratch[2 * bin + 1] = accIm[bin];
+    }
+
+    fft->performRealOnlyInverseTransform(fftScratch.data());
+
+    //the second half is the valid part of the circular convolution
+    std::copy(fftScratch.begin() + PartitionSize, fftScratch.begin() + 2 * PartitionSize, lowpass);
+}
+
+void LinearPhaseCrossover::buildKernels(KernelSet& kernels, const Cutoffs& cutoffs, juce::dsp::FFT& kernelFFT, std::vector<float>& scratch) const
+{
+    auto numBins = getNumBins();
+    auto spectrumSize = getSpectrumSize();
+    auto center = (kernelLength - 1) / 2;
+
+    std::vector<double> kernel(static_cast<size_t>(kernelLength));
+
+    for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+    {
+        //Blackman windowed sinc, normalised to unity gain at DC
+        auto fc = static_cast<double>(cutoffs[crossover]) / sampleRate;
+        auto sum = 0.0;
+        for ( int n = 0; n < kernelLength; ++n )
+        {
+            auto x = static_cast<double>(n - center);
+            auto sinc = n == center ? 2.0 * fc : std::sin(2.0 * juce::MathConstants<double>::pi * fc * x) / (juce::MathConstants<double>::pi * x);
+            auto phase = 2.0 * juce::MathConstants<double>::pi * n / (kernelLength - 1);
+            auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            kernel[static_cast<size_t>(n)] = sinc * window;
+            sum += kernel[static_cast<size_t>(n)];
+        }
+
+        for ( size_t partition = 0; partition < numPartitions; ++partition )
+        {
+            std::fill(scratch.begin(), scratch.end(), 0.f);
+            for ( size_t i = 0; i < static_cast<size_t>(PartitionSize); ++i )
+            {
+                auto n = partition * PartitionSize + i;
+                if ( n < kernel.size() )
+                    scratch[i] = static_cast<float>(kernel[n] / sum);
+            }
+
+            kernelFFT.performRealOnlyForwardTransform(scratch.data(), true);
+
+            auto* spectrum = kernels.spectra.data() + (crossover * numPartitions + partition) * spectrumSize;
+            for ( size_t bin = 0; bin < numBins; ++bin )
+            {
+                spectrum[bin] = scratch[2 * bin];
+                spectrum[numBins + bin] = scratch[2 * bin + 1];
+            }
+        }
+    }
+}
+
+void LinearPhaseCrossover::updateKernels()
+{
+    if ( isReady() )
+    {
+        rebuildKernelsIfNeeded();
+        return;
+    }
+
+    if ( ! kernelsRequested.load(std::memory_order_acquire) )
+        return;
+
+    auto version = requestedVersion.load(std::memory_order_acquire);
+
+    Cutoffs cutoffs;
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+        cutoffs[i] = requestedCutoffs[i].load(std::memory_order_relaxed);
+
+    builtVersion = version;
+    allocateBuffers(cutoffs);
+}
+
+void LinearPhaseCrossover::rebuildKernelsIfNeeded()
+{
+    auto version = requestedVersion.load(std::memory_order_acquire);
+    if ( version == builtVersion )
+        return;
+
+    Cutoffs cutoffs;
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+        cutoffs[i] = requestedCutoffs[i].load(std::memory_order_relaxed);
+
+    auto slots = kernelSlots.load(std::memory_order_acquire);
+
+    //nothing to build if the kernels in use already have these cutoffs
+    if ( getReadySlot(slots) == NoKernels && kernelSets[static_cast<size_t>(getActiveSlot(slots))].cutoffs == cutoffs )
+    {
+        builtVersion = version;
+        return;
+    }
+
+    //the audio thread only ever switches from the active set to the ready one and briefly holds
+    //the one it replaced, any other set is free; if there is none, the next time slice tries again
+    int target = 0;
+    while ( target == getActiveSlot(slots) || target == getReadySlot(slots) || target == getFadingSlot(slots) )
+        ++target;
+
+    if ( target == static_cast<int>(kernelSets.size()) )
+        return;
+
+    buildKernels(kernelSets[static_cast<size_t>(target)], cutoffs, *builderFFT, builderScratch);
+    kernelSets[static_cast<size_t>(target)].cutoffs = cutoffs;
+    builtVersion = version;
+
+    //an older set that was never picked up is simply dropped
+    while ( ! kernelSlots.compare_exchange_weak(slots, packSlots(getActiveSlot(slots), target, getFadingSlot(slots)), std::memory_order_acq_rel) )
+    {
+    }
+}
+
+template void LinearPhaseCrossover::process<float>(const juce::dsp::AudioBlock<float>&, const std::array<juce::dsp::AudioBlock<float>, NumBands>&);
+template void LinearPhaseCrossover::process<double>(const juce::dsp::AudioBlock<double>&, const std::array<juce::dsp::AudioBlock<double>, NumBands>&);
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    LinearPhaseCrossover.h
+    Created: 17 Oct 2026 3:12:36pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Crossover.h"
+
+/**
+ Linear phase alternative to Crossover, for phase coherent bands.
+
+ Crossover i is a windowed sinc lowpass LPi, all with the same length and center tap.
+ The bands are differences of the lowpassed signals,
+
+     band 0 = LP0,   band i = LPi - LP(i-1),   last band = delayed input - LP(last),
+
+ so they always sum to the input delayed by getLatencySamples().
+
+ The lowpasses run as uniformly partitioned overlap-save convolutions: the input is
+ transformed once per PartitionSize samples, and every lowpass is a complex multiply-add
+ over the last numPartitions input spectra followed by one inverse FFT.
+
+ When the cutoffs change, a background thread shared by every instance builds the new kernel
+ spectra and hands them over through an atomic index. The audio thread never allocates, locks
+ or waits for it, and crossfades from the old kernels' output to the new one over the partition
+ that picks them up, so a change never steps.
+
+ The buffers and kernel sets (about 300 KB for a stereo bus at 48 kHz) are only allocated once
+ the crossover is asked for: by prepare() right away, or by requestKernels() from the audio
+ thread, in which case the same background thread allocates and builds them and isReady() turns
+ true once it is done. Until then nothing but the sizes is kept.
+ */
+struct LinearPhaseCrossover
+{
+    static constexpr size_t MaxChannels = Crossover::MaxChannels;
+    static constexpr size_t NumBands = Crossover::NumBands;
+    static constexpr size_t NumCrossovers = NumBands - 1;
+    static constexpr int PartitionSize = 256;
+    static constexpr int FFTOrder = 9;
+    static_assert( (1 << FFTOrder) == 2 * PartitionSize, "the FFT covers two partitions" );
+
+    using Cutoffs = Crossover::Cutoffs;
+
+    LinearPhaseCrossover();
+    ~LinearPhaseCrossover();
+
+    //with allocate, allocates everything and builds the first kernels before returning,
+    //otherwise frees what an earlier prepare() allocated and leaves it to requestKernels()
+    void prepare(const juce::dsp::ProcessSpec& spec, const Cutoffs& cutoffs, bool allocate);
+    void reset();
+
+    //safe on the audio thread: has the background thread allocate and build the kernels, if they are not yet
+    //only the first call after prepare() or release() counts, later ones return right away
+    void requestKernels(const Cutoffs& cutoffs);
+
+    //true once the buffers and the first kernels are there, process() only works from then on
+    bool isReady() const { return ready.load(std::memory_order_acquire); }
+
+    //leaves the background thread and frees every buffer and kernel, prepare() again before the next process()
+    void release();
+
+    //the buffers and kernel sets, not the FFT engines' own tables, 0 until isReady()
+    size_t getAllocatedBytes() const;
+
+    //delay of every band against the input: half the kernel plus one partition
+    int getLatencySamples() const { return latency; }
+
+    //safe on the audio thread, the new kernels are swapped in once the background thread built them
+    //only call it while the crossover is in use, each call that changes a cutoff costs a rebuild
+    void setCutoffFrequencies(const Cutoffs& cutoffs);
+
+    //bands must hold at least as many channels and samples as input
+    //double blocks are converted on the way in and out, the convolution always runs in float
+    template<typename SampleType>
+    void process(const juce::dsp::AudioBlock<SampleType>& input, const std::array<juce::dsp::AudioBlock<SampleType>, NumBands>& bands);
+private:
+    //the kernel spectra of every crossover: [crossover][partition] of [re... | im...]
+    struct KernelSet
+    {
+        std::vector<float> spectra;
+        Cutoffs cutoffs {};
+    };
+
+    struct ChannelState
+    {
+        std::vector<float> inputFrame;          //last two partitions of input
+        std::vector<float> inputSpectra;        //frequency domain delay line: [partition] of [re... | im...]
+        std::vector<float> dryDelay;            //input, to delay it by the center tap
+        std::array<std::vector<float>, NumBands> bandFrames;
+    };
+
+    //one thread builds the kernels of every instance, they are only polled for new cutoffs
+    struct BuilderThread : juce::TimeSliceThread
+    {
+        BuilderThread() : juce::TimeSliceThread("Linear phase kernel builder") { startThread(); }
+        ~BuilderThread() override { stopThread(1000); }
+    };
+
+    struct KernelBuilder : juce::TimeSliceClient
+    {
+        explicit KernelBuilder(LinearPhaseCrossover& o) : owner(o) { }
+        int useTimeSlice() override { owner.updateKernels(); return 20; }
+
+        LinearPhaseCrossover& owner;
+    };
+
+    void allocateBuffers(const Cutoffs& cutoffs);
+    void freeBuffers();
+    void buildKernels(KernelSet& kernels, const Cutoffs& cutoffs, juce::dsp::FFT& fft, std::vector<float>& scratch) const;
+    void updateKernels();
+    void rebuildKernelsIfNeeded();
+
+    //fadingOut, if any, is the set the kernels replace, its output fades into theirs over the partition
+    void processPartition(ChannelState& state, const KernelSet& kernels, const KernelSet* fadingOut);
+    void convolve(const ChannelState& state, const KernelSet& kernels, size_t crossover, float* lowpass);
+    static void freeChannel(ChannelState& state);
+
+    size_t getNumBins() const { return static_cast<size_t>(PartitionSize) + 1; }
+    size_t getSpectrumSize() const { return 2 * getNumBins(); }
+
+    static constexpr int NoKernels = 0xff;
+    static constexpr uint32_t packSlots(int active, int ready, int fading = NoKernels)
+    {
+        return static_cast<uint32_t>(active) | (static_cast<uint32_t>(ready) << 8) | (static_cast<uint32_t>(fading) << 16);
+    }
+
+    static constexpr int getActiveSlot(uint32_t slots) { return static_cast<int>(slots & 0xff); }
+    static constexpr int getReadySlot(uint32_t slots) { return static_cast<int>((slots >> 8) & 0xff); }
+    static constexpr int getFadingSlot(uint32_t slots) { return static_cast<int>(slots >> 16); }
+
+    double sampleRate = 44100.0;
+    int kernelLength = 0;
+    int latency = 0;
+    size_t numPartitions = 0;
+
+    std::unique_ptr<juce::dsp::FFT> fft, builderFFT;
+    std::vector<float> fftScratch, builderScratch, accumulator;
+
+    //the lowpasses of the kernels fading out, one partition of every crossover
+    std::vector<float> fadeScratch;
+
+    std::array<ChannelState, MaxChannels> channels;
+    size_t numPreparedChannels = 0;
+    size_t framePosition = 0;
+    size_t spectrumPosition = 0;
+    size_t dryPosition = 0;
+
+    //three kernel sets: the one in use, at most one waiting, and one being built
+    //the active, the ready and the fading index live in one word so both threads see them change together;
+    //a set fading out is only held for the partition that swaps, the builder waits for it if it needs the slot
+    std::array<KernelSet, 3> kernelSets;
+    std::atomic<uint32_t> kernelSlots { packSlots(0, NoKernels) };
+
+    //the requested cutoffs, the version is bumped after they are written
+    std::array<std::atomic<float>, NumCrossovers> requestedCutoffs;
+    std::atomic<uint32_t> requestedVersion { 0 };
+    uint32_t builtVersion = 0;
+
+    //set by prepare() or requestKernels(), then the buffers are allocated once and ready is set
+    std::atomic<bool> kernelsRequested { false };
+    std::atomic<bool> ready { false };
+
+    juce::SharedResourcePointer<BuilderThread> builderThread;
+    KernelBuilder builder { *this };
+};
@@ -0,0 +1,238 @@
+/*
+  ==============================================================================
+
+    MultirateLowBand.cpp
+    Created: 17 Oct 2026 4:05:51pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "MultirateLowBand.h"
+
+int MultirateLowBand::getNumStages(double sampleRate)
+{
+    int stages = 0;
+    while ( stages < MaxStages && sampleRate / (1 << (stages + 1)) >= 22050.0 )
+        ++stages;
+
+    return stages;
+}
+
+Halfband::Design MultirateLowBand::getStageDesign(int stage, int numStages)
+{
+    //only the last stage's passband has to reach up the low band's slope, the ones before run at twice the rate or more
+    return stage == numStages - 1 ? Halfband::Design::Steep : Halfband::Design::Short;
+}
+
+int MultirateLowBand::getRoundTripDelay(int stages)
+{
+    //every stage s delays by its half-band's round trip at 1 / 2^s of the host rate,
+    //waiting for a whole low rate sample adds 2^stages - 1
+    auto delay = (1 << stages) - 1;
+    for ( int s = 0; s < stages; ++s )
+        delay += Halfband::get(getStageDesign(s, stages)).getRoundTripDelay() << s;
+
+    return delay;
+}
+
+float MultirateLowBand::getMaxCutoff(Params::CrossoverSlope slope) const
+{
+    if ( numStages == 0 )
+        return 0.f;
+
+    //the last stage runs at twice the low rate, its passband ends at 0.455 of the low rate
+    auto passband = 2.0 * Halfband::get(Halfband::Design::Steep).passband * lowSampleRate;
+
+    //the low band's LR slope (12, 24 or 48 dB per octave) has to be 60 dB down by then
+    auto dbPerOctave = 12.0 * (1 << static_cast<int>(slope));
+    return static_cast<float>(passband / std::exp2(60.0 / dbPerOctave));
+}
+
+size_t MultirateLowBand::getMaxHalfbandSamples(size_t maxBlockSize)
+{
+    //the first stage has the most: half the block plus the samples odd block sizes carry over
+    return ((maxBlockSize + 2) >> 1) + 1;
+}
+
+int MultirateLowBand::getMaxLatencySamples(const juce::dsp::ProcessSpec& spec)
+{
+    auto stages = getNumStages(spec.sampleRate);
+    auto factor = 1 << stages;
+    auto maxWindow = DynamicsKernel::lookAheadToSamples(Params::MaxLookAheadMs, spec.sampleRate / factor);
+
+    return getRoundTripDelay(stages) + maxWindow * factor;
+}
+
+size_t MultirateLowBand::getArenaSize(const juce::dsp::ProcessSpec& spec)
+{
+    auto maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+    auto stages = getNumStages(spec.sampleRate);
+
+    size_t size = BufferArena::getSliceSize(maxBlockSize + 2 * (size_t(1) << stages));
+    for ( int s = 0; s < stages; ++s )
+    {
+        auto levelSize = (maxBlockSize >> s) + 2;
+        size += BufferArena::getSliceSize((levelSize >> 1) + 2);
+    }
+
+    return size * spec.numChannels
+         + HalfbandWorkspace::getArenaSize(getMaxHalfbandSamples(maxBlockSize))
+         + ChannelCompressor::Detectors::getArenaSize(spec.numChannels, maxBlockSize);
+}
+
+void MultirateLowBand::prepare(const juce::dsp::ProcessSpec& spec, BufferArena& arena)
+{
+    jassert( spec.sampleRate > 0 );
+    jassert( spec.numChannels <= MaxChannels );
+
+    numStages = getNumStages(spec.sampleRate);
+    numPreparedChannels = spec.numChannels;
+    lowSampleRate = spec.sampleRate / getFactor();
+
+    latency = getRoundTripDelay(numStages);
+
+    auto maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+    outputSize = maxBlockSize + 2 * static_cast<size_t>(getFactor());
+
+    //every channel and stage runs one after the other, so they share the half-bands' blocks
+    halfbands.prepare(arena, getMaxHalfbandSamples(maxBlockSize));
+
+    //only the bus's channels get resamplers, the others are never touched
+    for ( size_t ch = 0; ch < numPreparedChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        for ( int s = 0; s < numStages; ++s )
+        {
+            //level s can hold a sample more than its share of the block, from odd block sizes
+            auto level = static_cast<size_t>(s);
+            auto levelSize = (maxBlockSize >> level) + 2;
+            state.decimators[level].prepare(halfbands, getStageDesign(s, numStages));
+            state.interpolators[level].prepare(halfbands, getStageDesign(s, numStages));
+            state.levels[level + 1] = arena.allocate((levelSize >> 1) + 2);
+        }
+
+        state.output = arena.allocate(outputSize);
+    }
+
+    //processDetector() links the full rate band, processLowBand() fewer low rate samples
+    detectors.prepare(arena, numPreparedChannels, maxBlockSize);
+    compressor.prepare(numPreparedChannels, DynamicsKernel::lookAheadToSamples(Params::MaxLookAheadMs, lowSampleRate), detectors);
+
+    setSettings(settings);
+    reset();
+}
+
+void MultirateLowBand::reset()
+{
+    resetResamplers();
+
+    compressor.reset();
+}
+
+void MultirateLowBand::resetResamplers()
+{
+    for ( size_t ch = 0; ch < numPreparedChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        for ( size_t s = 0; s < static_cast<size_t>(numStages); ++s )
+        {
+            state.decimators[s].reset();
+            state.interpolators[s].reset();
+        }
+
+        if ( state.output != nullptr )
+            std::fill(state.output, state.output + outputSize, 0.f);
+
+        state.numOutputSamples = static_cast<size_t>(getFactor() - 1);
+    }
+
+    detectorPhase = 0;
+    resamplersStale = false;
+}
+
+void MultirateLowBand::setSettings(const CompressorSettings& newSettings)
+{
+    settings = newSettings;
+
+    auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / lowSampleRate;
+    auto window = DynamicsKernel::lookAheadToSamples(settings.lookAhead, lowSampleRate);
+    lookAheadSamples = window * getFactor();
+
+    compressor.setSettings(settings, expFactor, window);
+}
+
+void MultirateLowBand::processLowBand(const juce::dsp::AudioBlock<float>& lowBand)
+{
+    auto numChannels = juce::jmin(lowBand.getNumChannels(), numPreparedChannels);
+    auto numSamples = lowBand.getNumSamples();
+
+    jassert( numStages > 0 );
+    jassert( numSamples + 2 * static_cast<size_t>(getFactor()) <= outputSize );
+
+    if ( resamplersStale )
+        resetResamplers();
+
+    size_t numLowSamples = 0;
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        const auto* in = lowBand.getChannelPointer(ch);
+        auto count = numSamples;
+
+        for ( size_t s = 0; s < static_cast<size_t>(numStages); ++s )
+        {
+            count = state.decimators[s].process(in, count, state.levels[s + 1]);
+            in = state.levels[s + 1];
+        }
+
+        //all channels are in the same phase, so they get the same number of low rate samples
+        numLowSamples = count;
+    }
+
+    std::array<float*, MaxChannels> low {};
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+        low[ch] = channels[ch].levels[static_cast<size_t>(numStages)];
+
+    compressor.process(low.data(), numChannels, numLowSamples);
+
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto& channel = channels[ch];
+        auto count = numLowSamples;
+
+        for ( auto s = static_cast<size_t>(numStages); s-- > 0; )
+        {
+            auto* out = s == 0 ? channel.output + channel.numOutputSamples : channel.levels[s];
+            channel.interpolators[s].process(channel.levels[s + 1], count, out);
+            count *= 2;
+        }
+
+        channel.numOutputSamples += count;
+        jassert( channel.numOutputSamples >= numSamples );
+
+        std::copy(channel.output, channel.output + numSamples, lowBand.getChannelPointer(ch));
+        std::copy(channel.output + numSamples, channel.output + channel.numOutputSamples, channel.output);
+        channel.numOutputSamples -= numSamples;
+    }
+}
+
+void MultirateLowBand::processDetector(const juce::dsp::AudioBlock<float>& lowBand)
+{
+    auto numChannels = juce::jmin(lowBand.getNumChannels(), numPreparedChannels);
+    auto numSamples = lowBand.getNumSamples();
+    auto phaseMask = static_cast<size_t>(getFactor() - 1);
+
+    jassert( numStages > 0 );
+
+    //the half-bands are skipped, when the band is back they start over from silence
+    resamplersStale = true;
+
+    std::array<const float*, MaxChannels> samples {};
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+        samples[ch] = lowBand.getChannelPointer(ch);
+
+    //plain subsampling is enough for a detector, the band has little left above the low rate's Nyquist
+    compressor.processDetector(samples.data(), numChannels, numSamples, 1, phaseMask + 1, detectorPhase);
+    detectorPhase = (detectorPhase + numSamples) & phaseMask;
+}
@@ -0,0 +1,127 @@
+/*
+  ==============================================================================
+
+    MultirateLowBand.h
+    Created: 17 Oct 2026 4:05:51pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParamSnapshot.h"
+#include "DynamicsKernel.h"
+#include "ChannelCompressor.h"
+#include "Halfband.h"
+
+/**
+ Compresses the low band at a fraction of the host rate.
+
+ The low band is decimated by 2, 4 or 8 with a cascade of polyphase half-bands, compressed at the low
+ rate and interpolated back with the same half-bands. The factor is the largest one that
+ keeps the low rate at or above 22.05 kHz: 2 at 44.1/48 kHz, 4 at 88.2/96 kHz, 8 at 176.4/192 kHz.
+ Below 44.1 kHz there is nothing to gain and getFactor() is 1.
+
+ Phase alignment: the half-bands are linear phase, so the round trip is a pure delay of
+ getLatencySamples() (full rate samples) for everything in their passband. The last stage
+ uses the steep half-band, whose passband reaches 0.455 of the low rate (10 kHz at 44.1 kHz),
+ the stages before it run at twice the rate or more and pass further with the short one.
+ The other bands have to be delayed by exactly the same amount (see BandAligner), then with
+ the compressors idle the band sum is still the crossover's allpass response, only later.
+ What the half-bands cut off is the low band's own LR slope beyond that passband, which is
+ only more than 60 dB down while the low cutoff is at most getMaxCutoff(); above it the
+ band must run at the host rate instead. With a low rate of 22.05 kHz (44.1, 88.2 and
+ 176.4 kHz) and 24 kHz (48, 96 and 192 kHz) that leaves
+
+     LR2    313 Hz    341 Hz
+     LR4   1774 Hz   1930 Hz
+     LR8   4218 Hz   4591 Hz
+
+ The look-ahead runs at the low rate, rounded to whole low rate samples,
+ which getLatencySamples() includes.
+
+ Every channel of the bus has its own half-bands, the compression itself is a ChannelCompressor
+ at the low rate, which links channels there.
+ */
+struct MultirateLowBand
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+    static constexpr int MaxStages = 3;
+
+    static size_t getArenaSize(const juce::dsp::ProcessSpec& spec);
+
+    //latency with the longest look-ahead, the most the low band can lag behind the others
+    static int getMaxLatencySamples(const juce::dsp::ProcessSpec& spec);
+
+    //takes its buffers from arena
+    void prepare(const juce::dsp::ProcessSpec& spec, BufferArena& arena);
+    void reset();
+
+    //frees the look-ahead storage, the arena slices are released with the arena
+    //prepare() again before the next process
+    void release() { compressor.release(); }
+    size_t getAllocatedBytes() const { return compressor.getAllocatedBytes(); }
+
+    void setSettings(const CompressorSettings& settings);
+    void setLinkGroups(const ChannelLinks::Groups& groups) { compressor.setLinkGroups(groups); }
+    void setLinkSettings(const LinkSettings& settings) { compressor.setLinkSettings(settings); }
+
+    //decimation factor of the low band, 1 when prepared below 44.1 kHz
+    int getFactor() const { return 1 << numStages; }
+    int getLatencySamples() const { return latency + lookAheadSamples; }
+
+    //the highest low band cutoff the half-bands pass 60 dB down its slope, 0 when getFactor() is 1
+    float getMaxCutoff(Params::CrossoverSlope slope) const;
+
+    //the half-band round trip alone, without the look-ahead
+    int getRoundTripSamples() const { return latency; }
+
+    //decimates, compresses and interpolates the low band in place, i.e. delayed by getLatencySamples()
+    void processLowBand(const juce::dsp::AudioBlock<float>& lowBand);
+
+    //for a low band nobody hears: only keeps the detector following it, at the low rate, and leaves it untouched
+    void processDetector(const juce::dsp::AudioBlock<float>& lowBand);
+
+    //metered at the low rate, since the last resetLevels()
+    BandLevels getLevels() const { return compressor.getLevels(); }
+    void resetLevels() { compressor.resetLevels(); }
+private:
+    static int getNumStages(double sampleRate);
+    static Halfband::Design getStageDesign(int stage, int numStages);
+    static int getRoundTripDelay(int numStages);
+    static size_t getMaxHalfbandSamples(size_t maxBlockSize);
+    void resetResamplers();
+
+    struct ChannelState
+    {
+        std::array<HalfbandDecimator, MaxStages> decimators;
+        std::array<HalfbandInterpolator, MaxStages> interpolators;
+
+        //levels[s] runs at 1 / 2^s of the host rate, levels[0] is unused
+        std::array<float*, MaxStages + 1> levels {};
+
+        //interpolated samples waiting to be handed out, the next low rate sample is due before they run out
+        float* output = nullptr;
+        size_t numOutputSamples = 0;
+    };
+
+    int numStages = 0;
+    int latency = 0;
+    double lowSampleRate = 44100.0;
+    size_t outputSize = 0;
+    size_t numPreparedChannels = 0;
+
+    std::array<ChannelState, MaxChannels> channels;
+    HalfbandWorkspace halfbands;
+
+    ChannelCompressor compressor;
+    ChannelCompressor::Detectors detectors;
+    CompressorSettings settings;
+    int lookAheadSamples = 0;
+
+    //set by processDetector(), which leaves the half-bands behind and subsamples on its own
+    bool resamplersStale = false;
+    size_t detectorPhase = 0;
+};
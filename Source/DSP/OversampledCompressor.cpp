@@ -0,0 +1,223 @@
+/*
+  ==============================================================================
+
+    OversampledCompressor.cpp
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "OversampledCompressor.h"
+
+size_t OversampledCompressor::Workspace::getArenaSize(const juce::dsp::ProcessSpec& spec)
+{
+    auto maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+
+    size_t levelsSize = 0;
+    for ( int s = 1; s <= MaxStages; ++s )
+        levelsSize += BufferArena::getSliceSize(maxBlockSize << s);
+
+    //the last interpolator gets 4 blocks, the last decimator turns 8 into 4 and one carried over
+    return levelsSize * spec.numChannels
+         + HalfbandWorkspace::getArenaSize((maxBlockSize << (MaxStages - 1)) + 1)
+         + ChannelCompressor::Detectors::getArenaSize(spec.numChannels, maxBlockSize << MaxStages);
+}
+
+void OversampledCompressor::Workspace::prepare(const juce::dsp::ProcessSpec& spec, BufferArena& arena)
+{
+    auto maxBlockSize = static_cast<size_t>(spec.maximumBlockSize);
+
+    levels = {};
+    for ( size_t ch = 0; ch < spec.numChannels; ++ch )
+    {
+        for ( size_t s = 1; s <= static_cast<size_t>(MaxStages); ++s )
+            levels[ch][s] = arena.allocate(maxBlockSize << s);
+    }
+
+    halfbands.prepare(arena, (maxBlockSize << (MaxStages - 1)) + 1);
+    detectors.prepare(arena, spec.numChannels, maxBlockSize << MaxStages);
+}
+
+Halfband::Design OversampledCompressor::getStageDesign(int stage)
+{
+    //only the first stage's passband has to reach the top of the host band
+    return stage == 0 ? Halfband::Design::Steep : Halfband::Design::Short;
+}
+
+int OversampledCompressor::getHighRateDelay(int stages)
+{
+    //stage s delays by its round trip in samples of 2^(s + 1) times the host rate
+    int delay = 0;
+    for ( int s = 0; s < stages; ++s )
+        delay += Halfband::get(getStageDesign(s)).getRoundTripDelay() << (stages - 1 - s);
+
+    return delay;
+}
+
+int OversampledCompressor::getLatencySamples(int stages)
+{
+    //the high rate delay, rounded up to host samples
+    auto factor = 1 << stages;
+    return (getHighRateDelay(stages) + factor - 1) / factor;
+}
+
+int OversampledCompressor::getPaddingSamples() const
+{
+    return getLatencySamples(numStages) * (1 << numStages) - getHighRateDelay(numStages);
+}
+
+void OversampledCompressor::prepare(const juce::dsp::ProcessSpec& spec, Workspace& newWorkspace)
+{
+    jassert( spec.sampleRate > 0 );
+    jassert( spec.numChannels <= MaxChannels );
+
+    sampleRate = spec.sampleRate;
+    numPreparedChannels = spec.numChannels;
+    workspace = &newWorkspace;
+
+    //only the bus's channels get resamplers, the others are never touched
+    for ( size_t ch = 0; ch < numPreparedChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        for ( int s = 0; s < MaxStages; ++s )
+        {
+            state.interpolators[static_cast<size_t>(s)].prepare(workspace->halfbands, getStageDesign(s));
+            state.decimators[static_cast<size_t>(s)].prepare(workspace->halfbands, getStageDesign(s));
+        }
+    }
+
+    compressor.prepare(numPreparedChannels, DynamicsKernel::lookAheadToSamples(Params::MaxLookAheadMs, sampleRate) * static_cast<int>(MaxFactor),
+                       workspace->detectors);
+
+    setSettings(settings);
+    reset();
+}
+
+void OversampledCompressor::reset()
+{
+    resetResamplers();
+
+    compressor.reset();
+}
+
+void OversampledCompressor::resetResamplers()
+{
+    for ( size_t ch = 0; ch < numPreparedChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        for ( size_t s = 0; s < static_cast<size_t>(MaxStages); ++s )
+        {
+            state.interpolators[s].reset();
+            state.decimators[s].reset();
+        }
+
+        state.padding.fill(0.f);
+    }
+
+    resamplersStale = false;
+}
+
+void OversampledCompressor::setSettings(const CompressorSettings& newSettings)
+{
+    settings = newSettings;
+
+    auto factor = 1 << numStages;
+    auto expFactor = -2.0 * juce::MathConstants<double>::pi * 1000.0 / (sampleRate * factor);
+    lookAheadSamples = DynamicsKernel::lookAheadToSamples(settings.lookAhead, sampleRate);
+
+    compressor.setSettings(settings, expFactor, lookAheadSamples * factor);
+}
+
+void OversampledCompressor::setNumStages(int newNumStages)
+{
+    jassert( juce::isPositiveAndNotGreaterThan(newNumStages, MaxStages) );
+
+    if ( newNumStages == numStages )
+        return;
+
+    numStages = newNumStages;
+
+    //the time constants depend on the rate the compressor runs at
+    setSettings(settings);
+    reset();
+}
+
+void OversampledCompressor::process(const juce::dsp::AudioBlock<float>& band)
+{
+    auto numChannels = juce::jmin(band.getNumChannels(), numPreparedChannels);
+    auto numSamples = band.getNumSamples();
+    auto stages = static_cast<size_t>(numStages);
+    auto numHighSamples = numSamples << stages;
+    auto padding = static_cast<size_t>(getPaddingSamples());
+
+    jassert( numStages > 0 );
+
+    if ( resamplersStale )
+        resetResamplers();
+
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto& state = channels[ch];
+        auto& levels = workspace->levels[ch];
+        const auto* in = band.getChannelPointer(ch);
+        auto count = numSamples;
+
+        for ( size_t s = 0; s < stages; ++s )
+        {
+            state.interpolators[s].process(in, count, levels[s + 1]);
+            in = levels[s + 1];
+            count *= 2;
+        }
+
+        //pads the delay to whole host samples, padding < factor <= numHighSamples
+        if ( padding > 0 )
+        {
+            auto* high = levels[stages];
+            std::array<float, MaxFactor> tail;
+            std::copy(high + numHighSamples - padding, high + numHighSamples, tail.begin());
+            std::copy_backward(high, high + numHighSamples - padding, high + numHighSamples);
+            std::copy(state.padding.begin(), state.padding.begin() + static_cast<long>(padding), high);
+            state.padding = tail;
+        }
+    }
+
+    std::array<float*, MaxChannels> high {};
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+        high[ch] = workspace->levels[ch][stages];
+
+    compressor.process(high.data(), numChannels, numHighSamples);
+
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+    {
+        auto& channel = channels[ch];
+        auto& levels = workspace->levels[ch];
+        auto count = numHighSamples;
+
+        for ( auto s = stages; s-- > 0; )
+        {
+            auto* out = s == 0 ? band.getChannelPointer(ch) : levels[s];
+            count = channel.decimators[s].process(levels[s + 1], count, out);
+        }
+    }
+}
+
+void OversampledCompressor::processDetector(const juce::dsp::AudioBlock<float>& band)
+{
+    auto numChannels = juce::jmin(band.getNumChannels(), numPreparedChannels);
+    auto numSamples = band.getNumSamples();
+    auto factor = size_t(1) << static_cast<size_t>(numStages);
+
+    jassert( numStages > 0 );
+
+    //the half-bands are skipped, when the band is back they start over from silence
+    resamplersStale = true;
+
+    std::array<const float*, MaxChannels> samples {};
+    for ( size_t ch = 0; ch < numChannels; ++ch )
+        samples[ch] = band.getChannelPointer(ch);
+
+    //each host sample is held for factor high rate samples, the time constants and the
+    //look-ahead window are in high rate samples
+    compressor.processDetector(samples.data(), numChannels, numSamples, factor);
+}
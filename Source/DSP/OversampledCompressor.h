@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+    OversampledCompressor.h
+    Created: 17 Oct 2026 5:02:19pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParamSnapshot.h"
+#include "DynamicsKernel.h"
+#include "ChannelCompressor.h"
+#include "Halfband.h"
+
+/**
+ The compressor of one band, run at 2x, 4x or 8x the host rate.
+
+ A fast attack multiplies the band with a gain that moves within a few samples, which
+ spreads its spectrum past Nyquist and folds back as aliasing. Here the band is
+ interpolated with polyphase half-bands, compressed at the high rate, and decimated
+ with the same half-bands, which remove what the gain changes added above the host band.
+
+ The round trip is linear phase. The first stage (host rate and 2x) uses the steep half-band,
+ which passes up to 0.455 of the host rate, 20 kHz at 44.1 kHz, and the stages above it the
+ short one, whose passband already reaches past the host band there. The delay is padded to
+ whole host samples at the high rate, giving getLatencySamples() of 55, 62 and 66 samples for
+ 2x, 4x and 8x.
+
+ Everything a band only needs while it runs (the resampled channels, the half-band blocks
+ and the linked detectors) lives in a Workspace sized for 8x, which every band shares since
+ they run one after the other. A band itself only keeps the half-band histories and its
+ look-ahead, so the factor can change on the audio thread and a band with oversampling Off
+ (which goes through DynamicsKernel as usual) holds no block sized buffers.
+
+ The look-ahead runs at the high rate too, over the same number of host samples,
+ which getLatencySamples() includes.
+
+ Every channel of the bus has its own half-bands, the compression itself is a ChannelCompressor
+ at the high rate, which links channels there.
+ */
+struct OversampledCompressor
+{
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+    static constexpr int MaxStages = 3;
+
+    /**
+     The buffers of one process() call at 8x: levels[ch][s] runs at 2^s times the host rate, and
+     the half-bands and the compressor work in their own blocks. One workspace serves every band
+     that is processed on the same thread, whatever their factors.
+     */
+    struct Workspace
+    {
+        static size_t getArenaSize(const juce::dsp::ProcessSpec& spec);
+        void prepare(const juce::dsp::ProcessSpec& spec, BufferArena& arena);
+    private:
+        friend struct OversampledCompressor;
+
+        std::array<std::array<float*, MaxStages + 1>, MaxChannels> levels {};
+        HalfbandWorkspace halfbands;
+        ChannelCompressor::Detectors detectors;
+    };
+
+    //latency of a given number of stages, 0 stages (off) has none
+    static int getLatencySamples(int numStages);
+
+    //keeps a pointer to workspace, which must have been prepared with the same spec
+    void prepare(const juce::dsp::ProcessSpec& spec, Workspace& workspace);
+    void reset();
+
+    //frees the look-ahead storage, the workspace is released with its arena
+    //prepare() again before the next process
+    void release() { compressor.release(); }
+    size_t getAllocatedBytes() const { return compressor.getAllocatedBytes(); }
+
+    void setSettings(const CompressorSettings& settings);
+    void setLinkGroups(const ChannelLinks::Groups& groups) { compressor.setLinkGroups(groups); }
+    void setLinkSettings(const LinkSettings& settings) { compressor.setLinkSettings(settings); }
+
+    //1 << numStages is the oversampling factor, resets the filters when it changes
+    void setNumStages(int numStages);
+    bool isEnabled() const { return numStages > 0; }
+
+    //resampler round trip plus look-ahead
+    int getLatencySamples() const { return getLatencySamples(numStages) + lookAheadSamples; }
+
+    //the half-band round trip alone, without the look-ahead
+    int getRoundTripSamples() const { return getLatencySamples(numStages); }
+
+    //compresses band in place, delayed by getLatencySamples()
+    void process(const juce::dsp::AudioBlock<float>& band);
+
+    //for a band nobody hears: only keeps the detector following band, which is left untouched
+    void processDetector(const juce::dsp::AudioBlock<float>& band);
+
+    //metered at the high rate, since the last resetLevels()
+    BandLevels getLevels() const { return compressor.getLevels(); }
+    void resetLevels() { compressor.resetLevels(); }
+private:
+    static constexpr size_t MaxFactor = size_t(1) << MaxStages;
+
+    struct ChannelState
+    {
+        std::array<HalfbandInterpolator, MaxStages> interpolators;
+        std::array<HalfbandDecimator, MaxStages> decimators;
+
+        //the padding delay at the high rate, see getLatencySamples()
+        std::array<float, MaxFactor> padding {};
+    };
+
+    static Halfband::Design getStageDesign(int stage);
+    static int getHighRateDelay(int numStages);
+    int getPaddingSamples() const;
+    void resetResamplers();
+
+    std::array<ChannelState, MaxChannels> channels;
+    Workspace* workspace = nullptr;
+    int numStages = 0;
+    double sampleRate = 44100.0;
+    size_t numPreparedChannels = 0;
+
+    ChannelCompressor compressor;
+    CompressorSettings settings;
+    int lookAheadSamples = 0;
+
+    //set by processDetector(), which leaves the half-bands behind
+    bool resamplersStale = false;
+};
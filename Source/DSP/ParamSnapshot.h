@@ -0,0 +1,101 @@
+/*
+  ==============================================================================
+
+    ParamSnapshot.h
+    Created: 17 Oct 2026 9:12:41am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "Params.h"
+
+/**
+ Holds the last values read from a group of parameters.
+ update() only reports a change when the new values differ from the stored ones,
+ so the (expensive) DSP setters behind it run only when something actually moved.
+ */
+template<typename SettingsType>
+struct ParamSnapshot
+{
+    bool update(const SettingsType& newSettings)
+    {
+        if ( valid && newSettings == settings )
+            return false;
+
+        settings = newSettings;
+        valid = true;
+        return true;
+    }
+
+    //forces the next update() to report a change, e.g. after prepareToPlay()
+    void invalidate() { valid = false; }
+
+    const SettingsType& get() const { return settings; }
+private:
+    SettingsType settings;
+    bool valid = false;
+};
+
+struct CompressorSettings
+{
+    float attack = 0.f;
+    float release = 0.f;
+    float threshold = 0.f;
+    float ratio = 1.f;
+    bool bypassed = false;
+
+    //in ms, 0 detects the sample itself
+    float lookAhead = 0.f;
+
+    bool operator==(const CompressorSettings& other) const
+    {
+        return attack == other.attack
+            && release == other.release
+            && threshold == other.threshold
+            && ratio == other.ratio
+            && bypassed == other.bypassed
+            && lookAhead == other.lookAhead;
+    }
+};
+
+template<size_t NumBands>
+struct CrossoverSettings
+{
+    //cutoffs[i] splits band i from band i + 1
+    std::array<float, NumBands - 1> cutoffs {};
+
+    bool operator==(const CrossoverSettings& other) const
+    {
+        return cutoffs == other.cutoffs;
+    }
+};
+
+struct GainSettings
+{
+    float inputGainDb = 0.f;
+    float outputGainDb = 0.f;
+
+    bool operator==(const GainSettings& other) const
+    {
+        return inputGainDb == other.inputGainDb
+            && outputGainDb == other.outputGainDb;
+    }
+};
+
+struct LinkSettings
+{
+    Params::LinkDetector detector = Params::LinkDetector::Max;
+
+    //0 detects every channel on its own, 1 only the group's detector
+    float amount = 1.f;
+
+    bool operator==(const LinkSettings& other) const
+    {
+        return detector == other.detector
+            && amount == other.amount;
+    }
+};
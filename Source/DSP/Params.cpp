@@ -1,11 +1,11 @@
-/*
-  ==============================================================================
-
-    Params.cpp
-    Created: 26 May 2024 9:31:58am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#include "Params.h"
+/*
+  ==============================================================================
+
+    Params.cpp
+    Created: 26 May 2024 9:31:58am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "Params.h"
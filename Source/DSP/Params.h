@@ -1,95 +1,295 @@
-/*
-  ==============================================================================
-
-    Params.h
-    Created: 26 May 2024 9:31:58am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-namespace Params
-{
-enum Names
-{
-    Low_mid_Crossover_Freq,
-    Mid_high_Crossover_Freq,
-    
-    Threshold_Low_Band,
-    Threshold_Mid_Band,
-    Threshold_High_Band,
-    
-    Attack_Low_Band,
-    Attack_Mid_Band,
-    Attack_High_Band,
-    
-    Release_Low_Band,
-    Release_Mid_Band,
-    Release_High_Band,
-    
-    Ratio_Low_Band,
-    Ratio_Mid_Band,
-    Ratio_High_Band,
-    
-    Bypass_Low_Band,
-    Bypass_Mid_Band,
-    Bypass_High_Band,
-    
-    Mute_Low_Band,
-    Mute_Mid_Band,
-    Mute_High_Band,
-    
-    Solo_Low_Band,
-    Solo_Mid_Band,
-    Solo_High_Band,
-    
-    Gain_In,
-    Gain_Out,
-};
-
-inline const std::map<Names, juce::String>& GetParams()
-{
-    static std::map<Names, juce::String> params =
-    {
-        {Low_mid_Crossover_Freq, "Low-Mid Crossover Freq"},
-        {Mid_high_Crossover_Freq, "Mid-High Crossover Freq"},
-
-        {Threshold_Low_Band, "Threshold Low Band"},
-        {Threshold_Mid_Band, "Threshold Mid Band"},
-        {Threshold_High_Band, "Threshold High Band"},
-
-        {Attack_Low_Band, "Attack Low Band"},
-        {Attack_Mid_Band, "Attack Mid Band"},
-        {Attack_High_Band, "Attack High Band"},
-
-        {Release_Low_Band, "Release Low Band"},
-        {Release_Mid_Band, "Release Mid Band"},
-        {Release_High_Band, "Release High Band"},
-
-        {Ratio_Low_Band, "Ratio Low Band"},
-        {Ratio_Mid_Band, "Ratio Mid Band"},
-        {Ratio_High_Band, "Ratio High Band"},
-
-        {Bypass_Low_Band, "Bypass Low Band"},
-        {Bypass_Mid_Band, "Bypass Mid Band"},
-        {Bypass_High_Band, "Bypass High Band"},
-        
-        {Mute_Low_Band, "Mute Low Band"},
-        {Mute_Mid_Band, "Mute Mid Band"},
-        {Mute_High_Band, "Mute High Band"},
-        
-        {Solo_Low_Band, "Solo Low Band"},
-        {Solo_Mid_Band, "Solo Mid Band"},
-        {Solo_High_Band, "Solo High Band"},
-        
-        {Gain_In, "Gain In"},
-        {Gain_Out, "Gain Out"},
-    };
-    
-    return params;
-}
-}
+/*
+  ==============================================================================
+
+    Params.h
+    Created: 26 May 2024 9:31:58am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//number of bands of the build, set it in the Projucer's preprocessor definitions (2 to 6)
+#ifndef SKWIEZOR_NUM_BANDS
+ #define SKWIEZOR_NUM_BANDS 3
+#endif
+
+namespace Params
+{
+constexpr size_t MinBands = 2;
+constexpr size_t MaxBands = 6;
+constexpr size_t NumBands = SKWIEZOR_NUM_BANDS;
+
+static_assert( NumBands >= MinBands && NumBands <= MaxBands, "SKWIEZOR_NUM_BANDS must be within 2 and 6" );
+
+//widest bus the processor takes: third order ambisonics, 7.1.4 has 12
+constexpr size_t MaxChannels = 16;
+
+enum Names
+{
+    Low_mid_Crossover_Freq,
+    Mid_high_Crossover_Freq,
+    
+    Threshold_Low_Band,
+    Threshold_Mid_Band,
+    Threshold_High_Band,
+    
+    Attack_Low_Band,
+    Attack_Mid_Band,
+    Attack_High_Band,
+    
+    Release_Low_Band,
+    Release_Mid_Band,
+    Release_High_Band,
+    
+    Ratio_Low_Band,
+    Ratio_Mid_Band,
+    Ratio_High_Band,
+    
+    Bypass_Low_Band,
+    Bypass_Mid_Band,
+    Bypass_High_Band,
+    
+    Mute_Low_Band,
+    Mute_Mid_Band,
+    Mute_High_Band,
+    
+    Solo_Low_Band,
+    Solo_Mid_Band,
+    Solo_High_Band,
+    
+    Gain_In,
+    Gain_Out,
+    
+    Linear_Phase,
+    
+    Channel_Link,
+    Link_Detector,
+    Link_Amount,
+};
+
+inline const std::map<Names, juce::String>& GetParams()
+{
+    static std::map<Names, juce::String> params =
+    {
+        {Low_mid_Crossover_Freq, "Low-Mid Crossover Freq"},
+        {Mid_high_Crossover_Freq, "Mid-High Crossover Freq"},
+
+        {Threshold_Low_Band, "Threshold Low Band"},
+        {Threshold_Mid_Band, "Threshold Mid Band"},
+        {Threshold_High_Band, "Threshold High Band"},
+
+        {Attack_Low_Band, "Attack Low Band"},
+        {Attack_Mid_Band, "Attack Mid Band"},
+        {Attack_High_Band, "Attack High Band"},
+
+        {Release_Low_Band, "Release Low Band"},
+        {Release_Mid_Band, "Release Mid Band"},
+        {Release_High_Band, "Release High Band"},
+
+        {Ratio_Low_Band, "Ratio Low Band"},
+        {Ratio_Mid_Band, "Ratio Mid Band"},
+        {Ratio_High_Band, "Ratio High Band"},
+
+        {Bypass_Low_Band, "Bypass Low Band"},
+        {Bypass_Mid_Band, "Bypass Mid Band"},
+        {Bypass_High_Band, "Bypass High Band"},
+        
+        {Mute_Low_Band, "Mute Low Band"},
+        {Mute_Mid_Band, "Mute Mid Band"},
+        {Mute_High_Band, "Mute High Band"},
+        
+        {Solo_Low_Band, "Solo Low Band"},
+        {Solo_Mid_Band, "Solo Mid Band"},
+        {Solo_High_Band, "Solo High Band"},
+        
+        {Gain_In, "Gain In"},
+        {Gain_Out, "Gain Out"},
+        
+        {Linear_Phase, "Linear Phase"},
+        
+        {Channel_Link, "Channel Link"},
+        {Link_Detector, "Link Detector"},
+        {Link_Amount, "Link Amount"},
+    };
+    
+    return params;
+}
+
+inline const std::vector<double>& GetRatioChoices()
+{
+    static std::vector<double> choices { 1, 1.5, 2, 3, 4, 5, 6, 8, 10, 15, 20, 50, 100 };
+    
+    return choices;
+}
+
+/**
+ Parameter names for any band count. The three band names are the ones in GetParams(),
+ so sessions saved by the 3-band build load unchanged.
+ */
+inline const std::vector<juce::String>& GetBandNames(size_t numBands = NumBands)
+{
+    static std::map<size_t, std::vector<juce::String>> bandNames =
+    {
+        {2, {"Low", "High"}},
+        {3, {"Low", "Mid", "High"}},
+        {4, {"Low", "Low Mid", "High Mid", "High"}},
+        {5, {"Low", "Low Mid", "Mid", "High Mid", "High"}},
+        {6, {"Sub", "Low", "Low Mid", "Mid", "High Mid", "High"}},
+    };
+    
+    return bandNames.at(numBands);
+}
+
+enum class BandParam
+{
+    Threshold,
+    Attack,
+    Release,
+    Ratio,
+    Bypass,
+    Mute,
+    Solo,
+    Oversampling,
+    LookAhead,
+};
+
+inline juce::String GetBandParamName(BandParam param, size_t band, size_t numBands = NumBands)
+{
+    static std::map<BandParam, juce::String> prefixes =
+    {
+        {BandParam::Threshold, "Threshold"},
+        {BandParam::Attack, "Attack"},
+        {BandParam::Release, "Release"},
+        {BandParam::Ratio, "Ratio"},
+        {BandParam::Bypass, "Bypass"},
+        {BandParam::Mute, "Mute"},
+        {BandParam::Solo, "Solo"},
+        {BandParam::Oversampling, "Oversampling"},
+        {BandParam::LookAhead, "Lookahead"},
+    };
+    
+    return prefixes.at(param) + " " + GetBandNames(numBands)[band] + " Band";
+}
+
+//choice index i runs the band's compressor at 2^i times the host rate, see OversampledCompressor
+inline const juce::StringArray& GetOversamplingChoices()
+{
+    static juce::StringArray choices { "Off", "2x", "4x", "8x" };
+    
+    return choices;
+}
+
+/**
+ Which channels share a detector, the GetChannelLinkChoices() in this order (see ChannelLinks).
+ Off compresses every channel on its own. Pairs links the mirrored channels of the bus layout
+ (L/R, Ls/Rs, the height pairs ...), consecutive channels of a discrete layout and all of an
+ ambisonic one, whose channels only make sense together. All links every channel, Custom takes
+ the groups given to SkwiezorMBAudioProcessor::setCustomLinkGroups().
+ */
+enum class ChannelLink
+{
+    Off,
+    Pairs,
+    All,
+    Custom,
+};
+
+inline const juce::StringArray& GetChannelLinkChoices()
+{
+    static juce::StringArray choices { "Off", "Pairs", "All", "Custom" };
+    
+    return choices;
+}
+
+/**
+ What a linked group detects, the GetLinkDetectorChoices() in this order: the loudest |sample|
+ of its channels (Max), so no channel goes over the threshold uncompressed, or their average
+ |sample| (Mean), which lets a single loud channel pull the group down less.
+ */
+enum class LinkDetector
+{
+    Max,
+    Mean,
+};
+
+inline const juce::StringArray& GetLinkDetectorChoices()
+{
+    static juce::StringArray choices { "Max", "Mean" };
+    
+    return choices;
+}
+
+//longest look-ahead of a band's detector, every look-ahead buffer is sized for it in prepareToPlay()
+constexpr float MaxLookAheadMs = 10.f;
+
+//crossover i splits band i from band i + 1
+inline juce::String GetCrossoverParamName(size_t crossover, size_t numBands = NumBands)
+{
+    const auto& bandNames = GetBandNames(numBands);
+    return bandNames[crossover] + "-" + bandNames[crossover + 1] + " Crossover Freq";
+}
+
+/**
+ Linkwitz-Riley order of one crossover point, the GetCrossoverSlopeParamName() choices in this order.
+ Per sample and channel, crossover i of the split tree (see CrossoverKernel) runs
+     LR2 (12 dB/oct): 1 section for the split + 1 per band below (1st order allpass)
+     LR4 (24 dB/oct): 3 sections for the split + 1 per band below
+     LR8 (48 dB/oct): 7 sections for the split + 2 per band below
+ and the HP side of a LR2 split is polarity inverted so the bands sum flat.
+ */
+enum class CrossoverSlope
+{
+    LR2,
+    LR4,
+    LR8,
+};
+
+inline const juce::StringArray& GetCrossoverSlopeChoices()
+{
+    static juce::StringArray choices { "12 dB/oct", "24 dB/oct", "48 dB/oct" };
+    
+    return choices;
+}
+
+inline juce::String GetCrossoverSlopeParamName(size_t crossover, size_t numBands = NumBands)
+{
+    const auto& bandNames = GetBandNames(numBands);
+    return bandNames[crossover] + "-" + bandNames[crossover + 1] + " Crossover Slope";
+}
+
+struct CrossoverRange
+{
+    float minimum, maximum, defaultValue;
+};
+
+//the ranges don't overlap, so the crossovers always stay in order
+inline const std::vector<CrossoverRange>& GetCrossoverRanges(size_t numBands = NumBands)
+{
+    static std::map<size_t, std::vector<CrossoverRange>> ranges =
+    {
+        {2, {{20.f, 20000.f, 1000.f}}},
+        {3, {{20.f, 999.f, 400.f}, {1000.f, 20000.f, 2000.f}}},
+        {4, {{20.f, 499.f, 200.f}, {500.f, 1999.f, 1000.f}, {2000.f, 20000.f, 5000.f}}},
+        {5, {{20.f, 249.f, 120.f}, {250.f, 999.f, 500.f}, {1000.f, 3999.f, 2000.f}, {4000.f, 20000.f, 8000.f}}},
+        {6, {{20.f, 149.f, 80.f}, {150.f, 499.f, 250.f}, {500.f, 1999.f, 1000.f}, {2000.f, 5999.f, 3500.f}, {6000.f, 20000.f, 10000.f}}},
+    };
+    
+    return ranges.at(numBands);
+}
+
+template<size_t NumBands>
+std::array<float, NumBands - 1> GetDefaultCrossoverFrequencies()
+{
+    const auto& ranges = GetCrossoverRanges(NumBands);
+    
+    std::array<float, NumBands - 1> frequencies;
+    for ( size_t i = 0; i < frequencies.size(); ++i )
+        frequencies[i] = ranges[i].defaultValue;
+    
+    return frequencies;
+}
+}
@@ -1,85 +1,126 @@
-/*
-  ==============================================================================
-
-    SingleChannelSampleFifo.h
-    Created: 27 May 2024 4:09:55pm
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-
-#include "Fifo.h"
-
-enum Channel
-{
-    Right, //effectively 0
-    Left //effectively 1
-};
-
-template<typename BlockType>
-struct SingleChannelSampleFifo
-{
-    SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
-    {
-        prepared.set(false);
-    }
-    
-    void update(const BlockType& buffer)
-    {
-        jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse );
-        auto* channelPtr = buffer.getReadPointer(channelToUse);
-        
-        for( int i = 0; i < buffer.getNumSamples(); ++i )
-        {
-            pushNextSampleIntoFifo(channelPtr[i]);
-        }
-    }
-
-    void prepare(int bufferSize)
-    {
-        prepared.set(false);
-        size.set(bufferSize);
-        
-        bufferToFill.setSize(1,             //channel
-                             bufferSize,    //num samples
-                             false,         //keepExistingContent
-                             true,          //clear extra space
-                             true);         //avoid reallocating
-        audioBufferFifo.prepare(1, bufferSize);
-        fifoIndex = 0;
-        prepared.set(true);
-    }
-    //==============================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
-    bool isPrepared() const { return prepared.get(); }
-    int getSize() const { return size.get(); }
-    //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
-private:
-    Channel channelToUse;
-    int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
-    BlockType bufferToFill;
-    juce::Atomic<bool> prepared = false;
-    juce::Atomic<int> size = 0;
-    
-    void pushNextSampleIntoFifo(float sample)
-    {
-        if (fifoIndex == bufferToFill.getNumSamples())
-        {
-            auto ok = audioBufferFifo.push(bufferToFill);
-
-            juce::ignoreUnused(ok);
-            
-            fifoIndex = 0;
-        }
-        
-        bufferToFill.setSample(0, fifoIndex, sample);
-        ++fifoIndex;
-    }
-};
+/*
+  ==============================================================================
+
+    SingleChannelSampleFifo.h
+    Created: 27 May 2024 4:09:55pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Fifo.h"
+
+enum Channel
+{
+    Right, //effectively 0
+    Left //effectively 1
+};
+
+template<typename BlockType>
+struct SingleChannelSampleFifo
+{
+    SingleChannelSampleFifo(Channel ch) : channelToUse(ch)
+    {
+        prepared.set(false);
+    }
+    
+    //the processor's float or double buffer, the analyzer always gets float
+    template<typename BufferType>
+    void update(const BufferType& buffer)
+    {
+        jassert(prepared.get());
+        jassert(buffer.getNumChannels() > 0 );
+        
+        //a mono bus feeds both analyzer channels
+        auto* channelPtr = buffer.getReadPointer(juce::jmin(channelToUse, buffer.getNumChannels() - 1));
+        
+        for( int i = 0; i < buffer.getNumSamples(); ++i )
+        {
+            pushNextSampleIntoFifo(static_cast<float>(channelPtr[i]));
+        }
+    }
+
+    //any channel of the bus, e.g. the front left of a surround layout, set before prepare()
+    void setChannel(int channel)
+    {
+        jassert( channel >= 0 );
+        channelToUse = channel;
+    }
+    
+    void prepare(int bufferSize)
+    {
+        const juce::ScopedLock sl(readLock);
+        
+        prepared.set(false);
+        size.set(bufferSize);
+        
+        bufferToFill.setSize(1,             //channel
+                             bufferSize,    //num samples
+                             false,         //keepExistingContent
+                             true,          //clear extra space
+                             true);         //avoid reallocating
+        audioBufferFifo.prepare(1, bufferSize);
+        fifoIndex = 0;
+        prepared.set(true);
+    }
+    
+    //frees the buffers until the next prepare(), update() must not run meanwhile
+    //readers may keep polling, they just find nothing
+    void release()
+    {
+        const juce::ScopedLock sl(readLock);
+        
+        prepared.set(false);
+        bufferToFill = BlockType();
+        audioBufferFifo.release();
+        fifoIndex = 0;
+    }
+    
+    size_t getAllocatedBytes() const
+    {
+        const juce::ScopedLock sl(readLock);
+        
+        auto numBytes = audioBufferFifo.getAllocatedBytes();
+        numBytes += static_cast<size_t>(bufferToFill.getNumChannels() * bufferToFill.getNumSamples()) * sizeof(float);
+        return numBytes;
+    }
+    //==============================================================================
+    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
+    bool isPrepared() const { return prepared.get(); }
+    int getSize() const { return size.get(); }
+    //==============================================================================
+    bool getAudioBuffer(BlockType& buf)
+    {
+        const juce::ScopedLock sl(readLock);
+        return audioBufferFifo.pull(buf);
+    }
+private:
+    int channelToUse;
+    int fifoIndex = 0;
+    Fifo<BlockType> audioBufferFifo;
+    BlockType bufferToFill;
+    juce::Atomic<bool> prepared = false;
+    juce::Atomic<int> size = 0;
+    
+    //the reader and prepare()/release() only, the audio thread never waits on it
+    juce::CriticalSection readLock;
+    
+    void pushNextSampleIntoFifo(float sample)
+    {
+        if (fifoIndex == bufferToFill.getNumSamples())
+        {
+            auto ok = audioBufferFifo.push(bufferToFill);
+
+            juce::ignoreUnused(ok);
+            
+            fifoIndex = 0;
+        }
+        
+        bufferToFill.setSample(0, fifoIndex, sample);
+        ++fifoIndex;
+    }
+};
@@ -1,32 +1,32 @@
-/*
-  ==============================================================================
-
-    CustomButtons.cpp
-    Created: 26 May 2024 9:15:38am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#include "CustomButtons.h"
-
-
-void AnalyzerButton::resized()
-{
-    auto bounds = getLocalBounds();
-    auto insetRect = bounds.reduced(4);
-    
-    randomPath.clear();
-    
-    juce::Random r;
-    
-    randomPath.startNewSubPath(insetRect.getX(),
-                               insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-    
-    for( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
-    {
-        randomPath.lineTo(x,
-                          insetRect.getY() + insetRect.getHeight() * r.nextFloat());
-    }
-}
-
+/*
+  ==============================================================================
+
+    CustomButtons.cpp
+    Created: 26 May 2024 9:15:38am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "CustomButtons.h"
+
+
+void AnalyzerButton::resized()
+{
+    auto bounds = getLocalBounds();
+    auto insetRect = bounds.reduced(4);
+    
+    randomPath.clear();
+    
+    juce::Random r;
+    
+    randomPath.startNewSubPath(insetRect.getX(),
+                               insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+    
+    for( auto x = insetRect.getX() + 1; x < insetRect.getRight(); x += 2 )
+    {
+        randomPath.lineTo(x,
+                          insetRect.getY() + insetRect.getHeight() * r.nextFloat());
+    }
+}
+
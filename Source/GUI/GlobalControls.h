@@ -1,31 +1,31 @@
-/*
-  ==============================================================================
-
-    GlobalControls.h
-    Created: 26 May 2024 9:30:22am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "RotarySliderWithLabels.h"
-#include "../DSP/Params.h"
-
-struct GlobalControls : juce::Component
-{
-    GlobalControls(juce::AudioProcessorValueTreeState& apvts);
-    
-    void paint(juce::Graphics& g) override;
-    
-    void resized() override;
-
-private:
-    using RSWL = RotarySliderWithLabels;
-    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
-    
-    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> lowMidXoverSliderAttachment, midHighXoverSliderAttachment, inGainSliderAttachment, outGainSliderAttachment;
-};
+/*
+  ==============================================================================
+
+    GlobalControls.h
+    Created: 26 May 2024 9:30:22am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "RotarySliderWithLabels.h"
+#include "../DSP/Params.h"
+
+struct GlobalControls : juce::Component
+{
+    GlobalControls(juce::AudioProcessorValueTreeState& apvts);
+    
+    void paint(juce::Graphics& g) override;
+    
+    void resized() override;
+
+private:
+    using RSWL = RotarySliderWithLabels;
+    std::unique_ptr<RSWL> inGainSlider, lowMidXoverSlider, midHighXoverSlider, outGainSlider;
+    
+    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    std::unique_ptr<Attachment> lowMidXoverSliderAttachment, midHighXoverSliderAttachment, inGainSliderAttachment, outGainSliderAttachment;
+};
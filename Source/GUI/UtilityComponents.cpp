@@ -1,24 +1,24 @@
-/*
-  ==============================================================================
-
-    UtilityComponents.cpp
-    Created: 26 May 2024 9:18:26am
-    Author:  David Werth
-
-  ==============================================================================
-*/
-
-#include "UtilityComponents.h"
-
-Placeholder::Placeholder()
-{
-    juce::Random r;
-    customColor = juce::Colour(r.nextInt(255), r.nextInt(255), r.nextInt(255));
-}
-
-void Placeholder::paint(juce::Graphics& g)
-{
-    g.fillAll(customColor);
-}
-
-RotarySlider::RotarySlider() : juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag, juce::Slider::TextEntryBoxPosition::NoTextBox) { }
+/*
+  ==============================================================================
+
+    UtilityComponents.cpp
+    Created: 26 May 2024 9:18:26am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "UtilityComponents.h"
+
+Placeholder::Placeholder()
+{
+    juce::Random r;
+    customColor = juce::Colour(r.nextInt(255), r.nextInt(255), r.nextInt(255));
+}
+
+void Placeholder::paint(juce::Graphics& g)
+{
+    g.fillAll(customColor);
+}
+
+RotarySlider::RotarySlider() : juce::Slider(juce::Slider::SliderStyle::RotaryHorizontalVerticalDrag, juce::Slider::TextEntryBoxPosition::NoTextBox) { }
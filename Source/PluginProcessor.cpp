@@ -1,457 +1,1142 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#include "PluginProcessor.h"
-#include "PluginEditor.h"
-#include "DSP/Params.h"
-
-//==============================================================================
-SkwiezorMBAudioProcessor::SkwiezorMBAudioProcessor()
-#ifndef JucePlugin_PreferredChannelConfigurations
-     : AudioProcessor (BusesProperties()
-                     #if ! JucePlugin_IsMidiEffect
-                      #if ! JucePlugin_IsSynth
-                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
-                      #endif
-                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
-                     #endif
-                       )
-#endif
-{
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    {
-        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName)));
-        jassert(param != nullptr);
-    };
-    
-    floatHelper(lowBandComp.attack,     Names::Attack_Low_Band);
-    floatHelper(lowBandComp.release,    Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold,  Names::Threshold_Low_Band);
-    
-    floatHelper(midBandComp.attack,     Names::Attack_Mid_Band);
-    floatHelper(midBandComp.release,    Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold,  Names::Threshold_Mid_Band);
-    
-    floatHelper(highBandComp.attack,    Names::Attack_High_Band);
-    floatHelper(highBandComp.release,   Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
-    
-    choiceHelper(lowBandComp.ratio,     Names::Ratio_Low_Band);
-    choiceHelper(midBandComp.ratio,     Names::Ratio_Mid_Band);
-    choiceHelper(highBandComp.ratio,    Names::Ratio_High_Band);
-    
-    boolHelper(lowBandComp.bypass,      Names::Bypass_Low_Band);
-    boolHelper(midBandComp.bypass,      Names::Bypass_Mid_Band);
-    boolHelper(highBandComp.bypass,     Names::Bypass_High_Band);
-    
-    boolHelper(lowBandComp.mute,        Names::Mute_Low_Band);
-    boolHelper(midBandComp.mute,        Names::Mute_Mid_Band);
-    boolHelper(highBandComp.mute,       Names::Mute_High_Band);
-    
-    boolHelper(lowBandComp.solo,        Names::Solo_Low_Band);
-    boolHelper(midBandComp.solo,        Names::Solo_Mid_Band);
-    boolHelper(highBandComp.solo,       Names::Solo_High_Band);
-    
-    floatHelper(lowMidCrossover,        Names::Low_mid_Crossover_Freq);
-    floatHelper(midHighCrossover,       Names::Mid_high_Crossover_Freq);
-
-    floatHelper(inputGainParam,         Names::Gain_In);
-    floatHelper(outputGainParam,         Names::Gain_Out);
-
-
-    LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP1.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-    
-    AP2.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
-    
-    LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
-    HP2.setType(juce::dsp::LinkwitzRileyFilterType::highpass);
-}
-
-SkwiezorMBAudioProcessor::~SkwiezorMBAudioProcessor()
-{
-}
-
-//==============================================================================
-const juce::String SkwiezorMBAudioProcessor::getName() const
-{
-    return JucePlugin_Name;
-}
-
-bool SkwiezorMBAudioProcessor::acceptsMidi() const
-{
-   #if JucePlugin_WantsMidiInput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SkwiezorMBAudioProcessor::producesMidi() const
-{
-   #if JucePlugin_ProducesMidiOutput
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-bool SkwiezorMBAudioProcessor::isMidiEffect() const
-{
-   #if JucePlugin_IsMidiEffect
-    return true;
-   #else
-    return false;
-   #endif
-}
-
-double SkwiezorMBAudioProcessor::getTailLengthSeconds() const
-{
-    return 0.0;
-}
-
-int SkwiezorMBAudioProcessor::getNumPrograms()
-{
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
-}
-
-int SkwiezorMBAudioProcessor::getCurrentProgram()
-{
-    return 0;
-}
-
-void SkwiezorMBAudioProcessor::setCurrentProgram (int index)
-{
-}
-
-const juce::String SkwiezorMBAudioProcessor::getProgramName (int index)
-{
-    return {};
-}
-
-void SkwiezorMBAudioProcessor::changeProgramName (int index, const juce::String& newName)
-{
-}
-
-//==============================================================================
-void SkwiezorMBAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    // Use this method as the place to do any pre-playback
-    // initialisation that you need..
-    
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.numChannels = getTotalNumOutputChannels();
-    spec.sampleRate = sampleRate;
-    
-    for ( auto& comp : compressors )
-        comp.prepare(spec);
-    
-    LP1.prepare(spec);
-    HP1.prepare(spec);
-    
-    AP2.prepare(spec);
-    
-    LP2.prepare(spec);
-    HP2.prepare(spec);
-    
-    inputGain.prepare(spec);
-    outputGain.prepare(spec);
-    
-    inputGain.setRampDurationSeconds(0.05);
-    outputGain.setRampDurationSeconds(0.05);
-    
-    for ( auto& buffer : filterBuffers )
-    {
-        buffer.setSize(spec.numChannels, samplesPerBlock);
-    }
-    
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
-    
-    osc.initialise([](float x){ return std::sin(x); });
-    osc.prepare(spec);
-//    osc.setFrequency(1000);
-    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
-    
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
-}
-
-void SkwiezorMBAudioProcessor::releaseResources()
-{
-    // When playback stops, you can use this as an opportunity to free up any
-    // spare memory, etc.
-}
-
-#ifndef JucePlugin_PreferredChannelConfigurations
-bool SkwiezorMBAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
-{
-  #if JucePlugin_IsMidiEffect
-    juce::ignoreUnused (layouts);
-    return true;
-  #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::mono()
-     && layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
-        return false;
-
-    // This checks if the input layout matches the output layout
-   #if ! JucePlugin_IsSynth
-    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
-        return false;
-   #endif
-
-    return true;
-  #endif
-}
-#endif
-
-void SkwiezorMBAudioProcessor::updateState()
-{
-    for ( auto& compressor : compressors )
-        compressor.updateCompressorSettings();
-    
-    auto lowMidCutoffFreq = lowMidCrossover->get();
-    LP1.setCutoffFrequency(lowMidCutoffFreq);
-    HP1.setCutoffFrequency(lowMidCutoffFreq);
-    
-    auto midHighCutoffFreq = midHighCrossover->get();
-    AP2.setCutoffFrequency(midHighCutoffFreq);
-    LP2.setCutoffFrequency(midHighCutoffFreq);
-    HP2.setCutoffFrequency(midHighCutoffFreq);
-    
-    inputGain.setGainDecibels(inputGainParam->get());
-    outputGain.setGainDecibels(outputGainParam->get());
-}
-
-void SkwiezorMBAudioProcessor::splitBands(const juce::AudioBuffer<float> &inputBuffer)
-{
-    for ( auto& filterBuffer : filterBuffers )
-        filterBuffer = inputBuffer;
-    
-    auto filterBuffer0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
-    auto filterBuffer1Block = juce::dsp::AudioBlock<float>(filterBuffers[1]);
-    auto filterBuffer2Block = juce::dsp::AudioBlock<float>(filterBuffers[2]);
-    
-    auto filterBuffer0Context = juce::dsp::ProcessContextReplacing<float>(filterBuffer0Block);
-    auto filterBuffer1Context = juce::dsp::ProcessContextReplacing<float>(filterBuffer1Block);
-    auto filterBuffer2Context = juce::dsp::ProcessContextReplacing<float>(filterBuffer2Block);
-    
-    LP1.process(filterBuffer0Context);
-    AP2.process(filterBuffer0Context);
-    
-    HP1.process(filterBuffer1Context);
-    filterBuffers[2] = filterBuffers[1];
-    LP2.process(filterBuffer1Context);
-    
-    HP2.process(filterBuffer2Context);
-}
-
-
-void SkwiezorMBAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
-    
-    // In case we have more outputs than inputs, this code clears any output
-    // channels that didn't contain input data, (because these aren't
-    // guaranteed to be empty - they may contain garbage).
-    // This is here to avoid people getting screaming feedback
-    // when they first compile a plugin, but obviously you don't need to keep
-    // this code if your algorithm always overwrites all the output channels.
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
-    
-    updateState();
-    
-    if ( false )
-    {
-        buffer.clear();
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        osc.process(ctx);
-        
-        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
-        gain.process(ctx);
-    }
-    
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
-    
-    applyGain(buffer, inputGain);
-    
-    splitBands(buffer);
-    
-    for ( size_t i = 0; i < filterBuffers.size(); ++i )
-        compressors[i].process(filterBuffers[i]);
-    
-    auto numSamples = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
-    
-    buffer.clear();
-    
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
-    {
-        for ( auto i = 0; i < nc; ++i )
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-    };
-    
-    auto bandsAreSoloed = false;
-    for ( auto& comp : compressors )
-    {
-        if ( comp.solo->get() )
-        {
-            bandsAreSoloed = true;
-            break;
-        }
-    }
-    
-    if ( bandsAreSoloed )
-    {
-        for ( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if ( comp.solo->get() && !comp.mute->get() )
-                addFilterBand(buffer, filterBuffers[i]);
-        }
-    }
-    else
-    {
-        for ( size_t i = 0; i < compressors.size(); ++i )
-        {
-            auto& comp = compressors[i];
-            if ( !comp.mute->get() )
-                addFilterBand(buffer, filterBuffers[i]);
-        }
-    }
-    
-    applyGain(buffer, outputGain);
-}
-
-//==============================================================================
-bool SkwiezorMBAudioProcessor::hasEditor() const
-{
-    return true; // (change this to false if you choose to not supply an editor)
-}
-
-juce::AudioProcessorEditor* SkwiezorMBAudioProcessor::createEditor()
-{
-    return new SkwiezorMBAudioProcessorEditor (*this);
-    // return new juce::GenericAudioProcessorEditor(*this);
-}
-
-//==============================================================================
-void SkwiezorMBAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
-{
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
-}
-
-void SkwiezorMBAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
-{
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-    if ( tree.isValid() )
-    {
-        apvts.replaceState(tree);
-    }
-}
-
-juce::AudioProcessorValueTreeState::ParameterLayout SkwiezorMBAudioProcessor::createParameterLayout()
-{
-    APVTS::ParameterLayout layout;
-    
-    using namespace juce;
-    using namespace Params;
-    const auto& params = GetParams();
-    
-    auto attackReleaseRange = NormalisableRange<float>(0.1, 500, 0.1, 1);
-    auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
-    
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 8, 10, 15, 20, 50, 100 };
-    juce::StringArray sa;
-    for ( auto choice : choices)
-    {
-        sa.add( juce::String(choice, 1) );
-    }
-    
-    auto gainRange = NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f);
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_In), 1}, params.at(Names::Gain_In), gainRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_Out), 1}, params.at(Names::Gain_Out), gainRange, 0));
-
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_Low_Band), 1}, params.at(Names::Threshold_Low_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_Mid_Band), 1}, params.at(Names::Threshold_Mid_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Threshold_High_Band), 1}, params.at(Names::Threshold_High_Band), thresholdRange, 0));
-        
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_Low_Band), 1}, params.at(Names::Attack_Low_Band), attackReleaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_Mid_Band), 1}, params.at(Names::Attack_Mid_Band), attackReleaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Attack_High_Band), 1}, params.at(Names::Attack_High_Band), attackReleaseRange, 50));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_Low_Band), 1}, params.at(Names::Release_Low_Band), attackReleaseRange, 250));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_Mid_Band), 1}, params.at(Names::Release_Mid_Band), attackReleaseRange, 250));
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Release_High_Band), 1}, params.at(Names::Release_High_Band), attackReleaseRange, 250));
-    
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_Low_Band), 1}, params.at(Names::Ratio_Low_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_Mid_Band), 1}, params.at(Names::Ratio_Mid_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Ratio_High_Band), 1}, params.at(Names::Ratio_High_Band), sa, 3));
-    
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypass_Low_Band), 1}, params.at(Names::Bypass_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypass_Mid_Band), 1}, params.at(Names::Bypass_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Bypass_High_Band), 1}, params.at(Names::Bypass_High_Band), false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_Low_Band), 1}, params.at(Names::Mute_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_Mid_Band), 1}, params.at(Names::Mute_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Mute_High_Band), 1}, params.at(Names::Mute_High_Band), false));
-    
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_Low_Band), 1}, params.at(Names::Solo_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_Mid_Band), 1}, params.at(Names::Solo_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Solo_High_Band), 1}, params.at(Names::Solo_High_Band), false));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Low_mid_Crossover_Freq), 1}, params.at(Names::Low_mid_Crossover_Freq), NormalisableRange<float>(MIN_FREQUENCY, 999, 1, 1), 400));
-    
-    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Mid_high_Crossover_Freq), 1}, params.at(Names::Mid_high_Crossover_Freq), NormalisableRange<float>(1000, MAX_FREQUENCY, 1, 1), 2000));
-    
-    
-
-    
-    return layout;
-}
-
-//==============================================================================
-// This creates new instances of the plugin..
-juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
-{
-    return new SkwiezorMBAudioProcessor();
-}
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#include "PluginProcessor.h"
+#include "PluginEditor.h"
+#include "DSP/Params.h"
+
+//==============================================================================
+SkwiezorMBAudioProcessor::SkwiezorMBAudioProcessor()
+#ifndef JucePlugin_PreferredChannelConfigurations
+     : AudioProcessor (BusesProperties()
+                     #if ! JucePlugin_IsMidiEffect
+                      #if ! JucePlugin_IsSynth
+                       .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
+                      #endif
+                       .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
+                     #endif
+                       )
+#endif
+{
+    using namespace Params;
+    const auto& params = GetParams();
+    
+    auto floatHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramName));
+        jassert(param != nullptr);
+    };
+    
+    auto choiceHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(paramName));
+        jassert(param != nullptr);
+    };
+    
+    auto boolHelper = [&apvts = this->apvts](auto& param, const juce::String& paramName)
+    {
+        param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(paramName));
+        jassert(param != nullptr);
+    };
+    
+    for ( size_t band = 0; band < compressors.size(); ++band )
+    {
+        auto& comp = compressors[band];
+        
+        floatHelper(comp.attack,        GetBandParamName(BandParam::Attack, band));
+        floatHelper(comp.release,       GetBandParamName(BandParam::Release, band));
+        floatHelper(comp.threshold,     GetBandParamName(BandParam::Threshold, band));
+        choiceHelper(comp.ratio,        GetBandParamName(BandParam::Ratio, band));
+        boolHelper(comp.bypass,         GetBandParamName(BandParam::Bypass, band));
+        boolHelper(comp.mute,           GetBandParamName(BandParam::Mute, band));
+        boolHelper(comp.solo,           GetBandParamName(BandParam::Solo, band));
+        choiceHelper(comp.oversampling, GetBandParamName(BandParam::Oversampling, band));
+        floatHelper(comp.lookAhead,     GetBandParamName(BandParam::LookAhead, band));
+    }
+    
+    for ( size_t i = 0; i < crossoverFreqs.size(); ++i )
+    {
+        floatHelper(crossoverFreqs[i],          GetCrossoverParamName(i));
+        choiceHelper(crossoverSlopeParams[i],   GetCrossoverSlopeParamName(i));
+    }
+
+    floatHelper(inputGainParam,         params.at(Names::Gain_In));
+    floatHelper(outputGainParam,        params.at(Names::Gain_Out));
+    boolHelper(linearPhaseParam,        params.at(Names::Linear_Phase));
+    choiceHelper(channelLinkParam,      params.at(Names::Channel_Link));
+    choiceHelper(linkDetectorParam,     params.at(Names::Link_Detector));
+    floatHelper(linkAmountParam,        params.at(Names::Link_Amount));
+    
+    auto unlinked = ChannelLinks::getUnlinkedGroups();
+    for ( size_t ch = 0; ch < MaxChannels; ++ch )
+        customLinkGroups[ch].store(unlinked[ch]);
+}
+
+SkwiezorMBAudioProcessor::~SkwiezorMBAudioProcessor()
+{
+    hibernationThread->removeTimeSliceClient(&hibernationClient);
+}
+
+//==============================================================================
+const juce::String SkwiezorMBAudioProcessor::getName() const
+{
+    return JucePlugin_Name;
+}
+
+bool SkwiezorMBAudioProcessor::acceptsMidi() const
+{
+   #if JucePlugin_WantsMidiInput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SkwiezorMBAudioProcessor::producesMidi() const
+{
+   #if JucePlugin_ProducesMidiOutput
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+bool SkwiezorMBAudioProcessor::isMidiEffect() const
+{
+   #if JucePlugin_IsMidiEffect
+    return true;
+   #else
+    return false;
+   #endif
+}
+
+double SkwiezorMBAudioProcessor::getTailLengthSeconds() const
+{
+    return tailLengthSeconds;
+}
+
+int SkwiezorMBAudioProcessor::getNumPrograms()
+{
+    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
+                // so this should be at least 1, even if you're not really implementing programs.
+}
+
+int SkwiezorMBAudioProcessor::getCurrentProgram()
+{
+    return 0;
+}
+
+void SkwiezorMBAudioProcessor::setCurrentProgram (int index)
+{
+}
+
+const juce::String SkwiezorMBAudioProcessor::getProgramName (int index)
+{
+    return {};
+}
+
+void SkwiezorMBAudioProcessor::changeProgramName (int index, const juce::String& newName)
+{
+}
+
+//==============================================================================
+void SkwiezorMBAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // Use this method as the place to do any pre-playback
+    // initialisation that you need..
+    
+    {
+        const juce::ScopedLock sl(engineLock);
+        
+        preparedSampleRate = sampleRate;
+        preparedBlockSize = samplesPerBlock;
+        preparedPrecision = getProcessingPrecision();
+        prepareEngine(sampleRate, samplesPerBlock);
+        engineState.store(EngineState::Awake, std::memory_order_release);
+    }
+    
+    hibernationThread->addTimeSliceClient(&hibernationClient);
+    
+    numSilentSamples = 0;
+    idle = false;
+    transportWasPlaying = false;
+}
+
+void SkwiezorMBAudioProcessor::prepareEngine(double sampleRate, int samplesPerBlock)
+{
+    juce::dsp::ProcessSpec spec;
+    spec.maximumBlockSize = samplesPerBlock;
+    spec.numChannels = getTotalNumOutputChannels();
+    spec.sampleRate = sampleRate;
+    
+    for ( auto& comp : compressors )
+        comp.prepare(spec);
+    
+    dynamics.prepare(spec, compressors.size(), preparedPrecision);
+    
+    //the most a band can lag behind the others, with the longest look-ahead
+    auto maxLookAhead = DynamicsKernel::lookAheadToSamples(Params::MaxLookAheadMs, sampleRate);
+    auto maxBandLatency = juce::jmax(MultirateLowBand::getMaxLatencySamples(spec),
+                                     OversampledCompressor::getLatencySamples(OversampledCompressor::MaxStages) + maxLookAhead);
+    
+    jassert( spec.numChannels <= MaxChannels );
+    auto usesDoubles = preparedPrecision == doublePrecision;
+    
+    arena.reserve((usesDoubles ? getPathArenaSize<double>(spec, maxBandLatency) : getPathArenaSize<float>(spec, maxBandLatency))
+                  + MultirateLowBand::getArenaSize(spec)
+                  + OversampledCompressor::Workspace::getArenaSize(spec));
+    
+    //the other path keeps nothing of the arena, it would dangle once the host switches back
+    forEachPath([](auto& path)
+    {
+        path.bandChannels = {};
+        path.bandAligner.release();
+    });
+    
+    if ( usesDoubles )
+        preparePath<double>(spec, maxBandLatency);
+    else
+        preparePath<float>(spec, maxBandLatency);
+    
+    scratchSize = samplesPerBlock;
+    scratchChannels = static_cast<int>(spec.numChannels);
+    
+    multirateLowBand.prepare(spec, arena);
+    oversamplingWorkspace.prepare(spec, arena);
+    
+    for ( size_t i = 0; i < NumBands; ++i )
+    {
+        oversampledCompressors[i].prepare(spec, oversamplingWorkspace);
+        oversampledCompressors[i].setNumStages(compressors[i].oversampling->getIndex());
+    }
+    
+    crossover.prepare(spec);
+    
+    Crossover::Cutoffs cutoffs;
+    for ( size_t i = 0; i < crossoverFreqs.size(); ++i )
+        cutoffs[i] = crossoverFreqs[i]->get();
+    
+    //starts right at the current cutoffs, only later changes glide
+    crossover.setCutoffFrequencies(cutoffs);
+    //the kernels are only allocated and built while they are heard, switching on later has the background thread do it
+    linearPhaseCrossover.prepare(spec, cutoffs, linearPhaseParam->get());
+    linearPhase = linearPhaseParam->get();
+    multirate = canUseMultirate();
+    
+    //the look-ahead is part of every band's latency, so the kernels get their settings before it is reported
+    for ( size_t i = 0; i < compressors.size(); ++i )
+    {
+        compressors[i].updateCompressorSettings();
+        dynamics.setBandSettings(i, compressors[i].getSettings());
+        oversampledCompressors[i].setSettings(compressors[i].getSettings());
+        
+        if ( i == 0 )
+            multirateLowBand.setSettings(compressors[i].getSettings());
+    }
+    
+    updateLatency();
+    
+    forEachPath([&spec](auto& path)
+    {
+        path.inputGain.prepare(spec);
+        path.outputGain.prepare(spec);
+        
+        path.inputGain.setRampDurationSeconds(0.05);
+        path.outputGain.setRampDurationSeconds(0.05);
+    });
+    
+    //the next updateState() hands the groups to the compressors just prepared
+    auto layout = getChannelLayoutOfBus(false, 0);
+    layoutPairs = ChannelLinks::getLayoutPairs(layout);
+    
+    crossoverSettings.invalidate();
+    crossoverSlopes.invalidate();
+    gainSettings.invalidate();
+    linkGroups.invalidate();
+    linkSettings.invalidate();
+    
+    //wider layouts show their front left and right, or their first two channels (ambisonics, discrete)
+    if ( spec.numChannels > 2 )
+    {
+        auto getIndex = [&layout](juce::AudioChannelSet::ChannelType type, int fallback)
+        {
+            auto index = layout.getChannelIndexForType(type);
+            return index >= 0 ? index : fallback;
+        };
+        
+        leftChannelFifo.setChannel(getIndex(juce::AudioChannelSet::left, 0));
+        rightChannelFifo.setChannel(getIndex(juce::AudioChannelSet::right, 1));
+    }
+    else
+    {
+        leftChannelFifo.setChannel(Channel::Left);
+        rightChannelFifo.setChannel(Channel::Right);
+    }
+    
+    leftChannelFifo.prepare(samplesPerBlock);
+    rightChannelFifo.prepare(samplesPerBlock);
+    
+    osc.initialise([](float x){ return std::sin(x); });
+    osc.prepare(spec);
+//    osc.setFrequency(1000);
+    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
+    
+    gain.prepare(spec);
+    gain.setGainDecibels(-12.f);
+}
+
+template<typename SampleType>
+size_t SkwiezorMBAudioProcessor::getPathArenaSize(const juce::dsp::ProcessSpec& spec, int maxBandLatency)
+{
+    auto size = NumBands * spec.numChannels * BufferArena::getSliceSize<SampleType>(spec.maximumBlockSize)
+              + BandAligner<NumBands, SampleType>::getArenaSize(maxBandLatency, spec.numChannels);
+    
+    if constexpr ( std::is_same_v<SampleType, double> )
+        size += spec.numChannels * BufferArena::getSliceSize(spec.maximumBlockSize);
+    
+    return size;
+}
+
+template<typename SampleType>
+void SkwiezorMBAudioProcessor::preparePath(const juce::dsp::ProcessSpec& spec, int maxBandLatency)
+{
+    auto& path = getPath<SampleType>();
+    
+    //band buffers first, see SignalPath
+    for ( auto& band : path.bandChannels )
+    {
+        for ( size_t ch = 0; ch < MaxChannels; ++ch )
+            band[ch] = ch < spec.numChannels ? arena.allocate<SampleType>(spec.maximumBlockSize) : nullptr;
+    }
+    
+    bandBufferBytes = NumBands * spec.numChannels * BufferArena::getSliceSize<SampleType>(spec.maximumBlockSize) * sizeof(float);
+    
+    resamplerStaging = {};
+    if constexpr ( std::is_same_v<SampleType, double> )
+    {
+        for ( size_t ch = 0; ch < spec.numChannels; ++ch )
+            resamplerStaging[ch] = arena.allocate(spec.maximumBlockSize);
+    }
+    
+    path.bandAligner.prepare(arena, maxBandLatency, spec.numChannels);
+}
+
+void SkwiezorMBAudioProcessor::releaseResources()
+{
+    // When playback stops, you can use this as an opportunity to free up any
+    // spare memory, etc.
+    
+    //waits for the background thread if it is just freeing or reserving
+    hibernationThread->removeTimeSliceClient(&hibernationClient);
+    
+    const juce::ScopedLock sl(engineLock);
+    releaseEngine();
+    engineState.store(EngineState::Hibernated, std::memory_order_release);
+}
+
+void SkwiezorMBAudioProcessor::releaseEngine()
+{
+    //the arena takes the band, resampler and alignment buffers with it, prepareEngine() carves them out again
+    forEachPath([](auto& path)
+    {
+        path.bandChannels = {};
+        path.bandAligner.release();
+    });
+    
+    resamplerStaging = {};
+    scratchSize = 0;
+    scratchChannels = 0;
+    bandBufferBytes = 0;
+    
+    leftChannelFifo.release();
+    rightChannelFifo.release();
+    
+    arena.release();
+    dynamics.release();
+    multirateLowBand.release();
+    for ( auto& oversampled : oversampledCompressors )
+        oversampled.release();
+    
+    linearPhaseCrossover.release();
+}
+
+int SkwiezorMBAudioProcessor::updateHibernation()
+{
+    const juce::ScopedLock sl(engineLock);
+    
+    //until the state is Freeing the audio thread can still take the buffers back as they are
+    auto state = EngineState::Hibernating;
+    if ( engineState.compare_exchange_strong(state, EngineState::Freeing, std::memory_order_acq_rel) )
+    {
+        releaseEngine();
+        
+        //fails if the audio thread asked for the engine back in the meantime, it is Waking then
+        state = EngineState::Freeing;
+        engineState.compare_exchange_strong(state, EngineState::Hibernated, std::memory_order_acq_rel);
+    }
+    
+    if ( engineState.load(std::memory_order_acquire) == EngineState::Waking )
+    {
+        prepareEngine(preparedSampleRate, preparedBlockSize);
+        engineState.store(EngineState::Awake, std::memory_order_release);
+    }
+    
+    //a hibernated engine is polled more often, every one of these ms is output the host does not get
+    return engineState.load(std::memory_order_relaxed) == EngineState::Hibernated ? 10 : 100;
+}
+
+SkwiezorMBAudioProcessor::MemoryReport SkwiezorMBAudioProcessor::getMemoryReport() const
+{
+    const juce::ScopedLock sl(engineLock);
+    
+    MemoryReport report;
+    report.bandBuffers = bandBufferBytes;
+    report.analyzerFifos = leftChannelFifo.getAllocatedBytes() + rightChannelFifo.getAllocatedBytes();
+    report.resamplers = arena.getNumReserved() * sizeof(float) - bandBufferBytes;
+    report.lookAhead = dynamics.getAllocatedBytes() + multirateLowBand.getAllocatedBytes();
+    for ( const auto& oversampled : oversampledCompressors )
+        report.lookAhead += oversampled.getAllocatedBytes();
+    
+    report.linearPhase = linearPhaseCrossover.getAllocatedBytes();
+    report.hibernating = engineState.load(std::memory_order_acquire) != EngineState::Awake;
+    return report;
+}
+
+#ifndef JucePlugin_PreferredChannelConfigurations
+bool SkwiezorMBAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
+{
+  #if JucePlugin_IsMidiEffect
+    juce::ignoreUnused (layouts);
+    return true;
+  #else
+    //mono, stereo, surround up to 7.1.4, ambisonics up to 3rd order and discrete layouts,
+    //as long as the band buffers and the compressors have room for every channel
+    auto output = layouts.getMainOutputChannelSet();
+    if ( output.isDisabled() || output.size() > static_cast<int>(MaxChannels) )
+        return false;
+
+    // This checks if the input layout matches the output layout
+   #if ! JucePlugin_IsSynth
+    if (layouts.getMainOutputChannelSet() != layouts.getMainInputChannelSet())
+        return false;
+   #endif
+
+    return true;
+  #endif
+}
+#endif
+
+void SkwiezorMBAudioProcessor::updateState(int numSamples)
+{
+    dynamics.setControlInterval(gainControlInterval);
+    
+    auto latencyChanged = false;
+    for ( size_t i = 0; i < compressors.size(); ++i )
+    {
+        auto oldLookAhead = compressors[i].getSettings().lookAhead;
+        if ( compressors[i].updateCompressorSettings() )
+        {
+            latencyChanged = latencyChanged || compressors[i].getSettings().lookAhead != oldLookAhead;
+
+            dynamics.setBandSettings(i, compressors[i].getSettings());
+            
+            oversampledCompressors[i].setSettings(compressors[i].getSettings());
+            
+            if ( i == 0 )
+                multirateLowBand.setSettings(compressors[i].getSettings());
+        }
+    }
+    
+    for ( size_t i = 0; i < compressors.size(); ++i )
+    {
+        auto& oversampled = oversampledCompressors[i];
+        auto oldLatency = oversampled.getLatencySamples();
+        
+        oversampled.setNumStages(compressors[i].oversampling->getIndex());
+        latencyChanged = latencyChanged || oversampled.getLatencySamples() != oldLatency;
+    }
+    
+    CrossoverSettings<NumBands> newCrossoverSettings;
+    for ( size_t i = 0; i < crossoverFreqs.size(); ++i )
+        newCrossoverSettings.cutoffs[i] = crossoverFreqs[i]->get();
+    
+    if ( crossoverSettings.update(newCrossoverSettings) )
+    {
+        //the host hands out one value per block, gliding to it over the block makes
+        //automation piecewise linear instead of stepping at every block boundary
+        crossover.setCutoffFrequencies(crossoverSettings.get().cutoffs, numSamples);
+        
+        //the kernels are only rebuilt while they are heard, switching on catches up below
+        if ( linearPhase )
+            linearPhaseCrossover.setCutoffFrequencies(crossoverSettings.get().cutoffs);
+    }
+    
+    if ( linearPhaseParam->get() && ! linearPhaseCrossover.isReady() )
+    {
+        //the first switch on waits for the background thread to allocate the kernels, the IIR crossover carries on until then
+        linearPhaseCrossover.requestKernels(crossoverSettings.get().cutoffs);
+    }
+    else if ( linearPhaseParam->get() != linearPhase )
+    {
+        linearPhase = linearPhaseParam->get();
+        
+        //the engine taking over starts from silence instead of stale state
+        if ( linearPhase )
+        {
+            linearPhaseCrossover.reset();
+            linearPhaseCrossover.setCutoffFrequencies(crossoverSettings.get().cutoffs);
+        }
+        else
+        {
+            crossover.reset();
+        }
+        
+        latencyChanged = true;
+    }
+    
+    Crossover::Slopes newSlopes;
+    for ( size_t i = 0; i < crossoverSlopeParams.size(); ++i )
+        newSlopes[i] = static_cast<Params::CrossoverSlope>(crossoverSlopeParams[i]->getIndex());
+    
+    if ( crossoverSlopes.update(newSlopes) )
+        crossover.setSlopes(crossoverSlopes.get());
+    
+    auto newMultirate = canUseMultirate();
+    if ( newMultirate != multirate )
+    {
+        multirate = newMultirate;
+        
+        if ( multirate )
+            multirateLowBand.reset();
+        
+        latencyChanged = true;
+    }
+    
+    if ( latencyChanged )
+        updateLatency();
+    
+    auto newLinkGroups = ChannelLinks::getUnlinkedGroups();
+    switch ( static_cast<Params::ChannelLink>(channelLinkParam->getIndex()) )
+    {
+        case Params::ChannelLink::Off:
+            break;
+        case Params::ChannelLink::Pairs:
+            newLinkGroups = layoutPairs;
+            break;
+        case Params::ChannelLink::All:
+            newLinkGroups = ChannelLinks::getAllLinkedGroups();
+            break;
+        case Params::ChannelLink::Custom:
+            for ( size_t ch = 0; ch < MaxChannels; ++ch )
+                newLinkGroups[ch] = customLinkGroups[ch].load(std::memory_order_relaxed);
+            break;
+    }
+    
+    if ( linkGroups.update(newLinkGroups) )
+    {
+        dynamics.setLinkGroups(linkGroups.get());
+        multirateLowBand.setLinkGroups(linkGroups.get());
+        for ( auto& oversampled : oversampledCompressors )
+            oversampled.setLinkGroups(linkGroups.get());
+    }
+    
+    if ( linkSettings.update({ static_cast<Params::LinkDetector>(linkDetectorParam->getIndex()), linkAmountParam->get() / 100.f }) )
+    {
+        dynamics.setLinkSettings(linkSettings.get());
+        multirateLowBand.setLinkSettings(linkSettings.get());
+        for ( auto& oversampled : oversampledCompressors )
+            oversampled.setLinkSettings(linkSettings.get());
+    }
+    
+    if ( gainSettings.update({ inputGainParam->get(), outputGainParam->get() }) )
+    {
+        forEachPath([this](auto& path)
+        {
+            path.inputGain.setGainDecibels(gainSettings.get().inputGainDb);
+            path.outputGain.setGainDecibels(gainSettings.get().outputGainDb);
+        });
+    }
+}
+
+bool SkwiezorMBAudioProcessor::canUseMultirate() const
+{
+    //a low cutoff past the half-bands' passband (a 2 band layout reaches 20 kHz) keeps the band at the host rate
+    auto slope = static_cast<Params::CrossoverSlope>(crossoverSlopeParams[0]->getIndex());
+    return useMultirateLowBand && multirateLowBand.getFactor() > 1
+        && crossoverFreqs[0]->get() <= multirateLowBand.getMaxCutoff(slope);
+}
+
+void SkwiezorMBAudioProcessor::updateLatency()
+{
+    //the multirate low band has its own compressor, so the band's oversampling is ignored there
+    std::array<int, NumBands> bandLatencies;
+    auto longestRoundTrip = 0;
+    for ( size_t i = 0; i < NumBands; ++i )
+    {
+        const auto& oversampled = oversampledCompressors[i];
+        
+        if ( multirate && i == 0 )
+        {
+            bandLatencies[i] = multirateLowBand.getLatencySamples();
+            longestRoundTrip = juce::jmax(longestRoundTrip, multirateLowBand.getRoundTripSamples());
+        }
+        else if ( oversampled.isEnabled() )
+        {
+            bandLatencies[i] = oversampled.getLatencySamples();
+            longestRoundTrip = juce::jmax(longestRoundTrip, oversampled.getRoundTripSamples());
+        }
+        else
+        {
+            bandLatencies[i] = dynamics.getLookAheadSamples(i);
+        }
+    }
+    
+    forEachPath([&bandLatencies](auto& path) { path.bandAligner.setBandLatencies(bandLatencies); });
+    
+    auto crossoverLatency = linearPhase ? linearPhaseCrossover.getLatencySamples() : 0;
+    auto latency = crossoverLatency + floatPath.bandAligner.getLatencySamples();
+    setLatencySamples(latency);
+    
+    //the linear phase filters (crossover kernels, half-bands) are symmetric around their delay,
+    //so they ring on for that long again once the delayed input has come out;
+    //look-ahead and alignment are plain delays, and the IIR crossover's own decay is not counted
+    auto ringing = longestRoundTrip;
+    if ( linearPhase )
+        ringing += crossoverLatency - LinearPhaseCrossover::PartitionSize;
+    
+    tailLengthSeconds = getSampleRate() > 0.0 ? (latency + ringing) / getSampleRate() : 0.0;
+}
+
+int SkwiezorMBAudioProcessor::getSilenceTimeoutSamples() const
+{
+    //-150 dB takes ln(10^7.5) = 17.3 time constants of an exponential decay, below the 24 bit floor
+    constexpr double numTimeConstants = 17.3;
+    constexpr double twoPi = juce::MathConstants<double>::twoPi;
+    
+    //the slowest crossover poles: the lowest cutoff, at the lowest damping any slope uses (LR8, 0.38)
+    auto crossoverDecay = numTimeConstants / (0.38 * twoPi * crossoverFreqs[0]->get());
+    
+    //the ballistics filters release with a time constant of release / 2 pi
+    auto longestRelease = 0.f;
+    for ( auto& comp : compressors )
+        longestRelease = juce::jmax(longestRelease, comp.release->get());
+    
+    auto envelopeDecay = numTimeConstants * longestRelease / (1000.0 * twoPi);
+    
+    return static_cast<int>(std::ceil((tailLengthSeconds + crossoverDecay + envelopeDecay) * getSampleRate()));
+}
+
+template<typename SampleType>
+bool SkwiezorMBAudioProcessor::skipSilentBlock(juce::AudioBuffer<SampleType>& buffer)
+{
+    auto numSamples = buffer.getNumSamples();
+    auto silent = useSilenceSkipping && buffer.getMagnitude(0, numSamples) == SampleType(0);
+    
+    //a transport that just started wakes the engine ahead of its input
+    auto playing = isTransportPlaying();
+    auto started = playing && ! transportWasPlaying;
+    transportWasPlaying = playing;
+    
+    if ( engineState.load(std::memory_order_acquire) != EngineState::Awake )
+    {
+        auto awake = (! silent || started) && wakeEngine();
+        if ( ! awake )
+        {
+            buffer.clear();
+            numSkippedBlocks.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    
+    if ( ! silent )
+    {
+        //carries on from the state it was reset to, which is what it had decayed to anyway
+        numSilentSamples = 0;
+        idle = false;
+        return false;
+    }
+    
+    if ( ! idle )
+    {
+        //silent blocks are still processed until everything has rung out below the floor
+        if ( numSilentSamples < getSilenceTimeoutSamples() )
+        {
+            numSilentSamples += numSamples;
+            return false;
+        }
+        
+        //clears what is left below the floor, so nothing old comes out when the input is back
+        crossover.reset();
+        linearPhaseCrossover.reset();
+        dynamics.reset();
+        multirateLowBand.reset();
+        for ( auto& oversampled : oversampledCompressors )
+            oversampled.reset();
+        
+        forEachPath([](auto& path) { path.bandAligner.reset(); });
+        
+        for ( auto& comp : compressors )
+            comp.publishLevels({});
+        
+        idle = true;
+        numSilentSamples = 0;
+    }
+    
+    //parameters still follow, but jump instead of gliding: nothing plays, and the first block
+    //that does should sound the way it would have after all these blocks
+    updateState(0);
+    forEachPath([](auto& path)
+    {
+        path.inputGain.reset();
+        path.outputGain.reset();
+    });
+    
+    buffer.clear();
+    numSkippedBlocks.fetch_add(1, std::memory_order_relaxed);
+    
+    //from here on the background thread owns the buffers, so this is the last touch
+    numSilentSamples += numSamples;
+    if ( shouldHibernate() )
+        engineState.store(EngineState::Hibernating, std::memory_order_release);
+    
+    return true;
+}
+
+bool SkwiezorMBAudioProcessor::wakeEngine()
+{
+    //never waits for the background thread, whatever it is doing
+    auto state = engineState.load(std::memory_order_acquire);
+    
+    for ( ;; )
+    {
+        if ( state == EngineState::Awake )
+            return true;
+        
+        if ( state == EngineState::Waking )
+            return false;
+        
+        if ( state == EngineState::Hibernating )
+        {
+            //nothing was freed yet, the reset buffers are used as they are
+            if ( engineState.compare_exchange_weak(state, EngineState::Awake, std::memory_order_acq_rel) )
+                return true;
+        }
+        else if ( engineState.compare_exchange_weak(state, EngineState::Waking, std::memory_order_acq_rel) )
+        {
+            //Freeing or Hibernated, the background thread reserves the engine again and publishes Awake
+            numSilentSamples = 0;
+            return false;
+        }
+    }
+}
+
+bool SkwiezorMBAudioProcessor::shouldHibernate()
+{
+    //an offline render never waits for anything, there is no point in freeing and reserving in between
+    if ( isNonRealtime() )
+        return false;
+    
+    auto hibernateAfter = hibernateAfterSeconds.load(std::memory_order_relaxed);
+    if ( hibernateAfter > 0.0 && static_cast<double>(numSilentSamples) >= hibernateAfter * getSampleRate() )
+        return true;
+    
+    if ( ! hibernateWhenStopped )
+        return false;
+    
+    auto* playHead = getPlayHead();
+    if ( playHead == nullptr )
+        return false;
+    
+    auto position = playHead->getPosition();
+    return position.hasValue() && ! position->getIsPlaying();
+}
+
+bool SkwiezorMBAudioProcessor::isTransportPlaying()
+{
+    auto* playHead = getPlayHead();
+    if ( playHead == nullptr )
+        return false;
+    
+    auto position = playHead->getPosition();
+    return position.hasValue() && position->getIsPlaying();
+}
+
+template<typename SampleType>
+std::array<juce::dsp::AudioBlock<SampleType>, SkwiezorMBAudioProcessor::NumBands> SkwiezorMBAudioProcessor::getBandBlocks(size_t numChannels, size_t numSamples)
+{
+    auto& path = getPath<SampleType>();
+    
+    std::array<juce::dsp::AudioBlock<SampleType>, NumBands> blocks;
+    for ( size_t i = 0; i < NumBands; ++i )
+        blocks[i] = juce::dsp::AudioBlock<SampleType>(path.bandChannels[i].data(), numChannels, numSamples);
+    
+    return blocks;
+}
+
+template<typename SampleType>
+void SkwiezorMBAudioProcessor::splitBands(const juce::dsp::AudioBlock<SampleType>& inputBlock)
+{
+    auto bandBlocks = getBandBlocks<SampleType>(inputBlock.getNumChannels(), inputBlock.getNumSamples());
+    
+    if ( linearPhase )
+        linearPhaseCrossover.process(inputBlock, bandBlocks);
+    else
+        crossover.process(inputBlock, bandBlocks);
+}
+
+template<typename SampleType, typename Function>
+void SkwiezorMBAudioProcessor::processAsFloat(const juce::dsp::AudioBlock<SampleType>& band, Function&& process)
+{
+    if constexpr ( std::is_same_v<SampleType, float> )
+    {
+        process(band);
+    }
+    else
+    {
+        auto numChannels = band.getNumChannels();
+        auto numSamples = band.getNumSamples();
+        auto staging = juce::dsp::AudioBlock<float>(resamplerStaging.data(), numChannels, numSamples);
+        
+        for ( size_t ch = 0; ch < numChannels; ++ch )
+        {
+            const auto* samples = band.getChannelPointer(ch);
+            std::copy(samples, samples + numSamples, staging.getChannelPointer(ch));
+        }
+        
+        process(staging);
+        
+        for ( size_t ch = 0; ch < numChannels; ++ch )
+        {
+            const auto* samples = staging.getChannelPointer(ch);
+            std::copy(samples, samples + numSamples, band.getChannelPointer(ch));
+        }
+    }
+}
+
+template<typename SampleType>
+void SkwiezorMBAudioProcessor::processChunk(juce::dsp::AudioBlock<SampleType> block, const std::array<bool, NumBands>& audibleBands)
+{
+    auto& path = getPath<SampleType>();
+    
+    applyGain(block, path.inputGain);
+    
+    splitBands(block);
+    
+    auto bandBlocks = getBandBlocks<SampleType>(block.getNumChannels(), block.getNumSamples());
+    
+    //bands that are resampled have their own compressors
+    std::array<bool, NumBands> resampledBands;
+    for ( size_t i = 0; i < NumBands; ++i )
+        resampledBands[i] = oversampledCompressors[i].isEnabled() || (multirate && i == 0);
+    
+    //bands that cannot reach the output only keep their detectors running, so they come back at the right gain
+    std::array<bool, NumBands> deadBands;
+    for ( size_t i = 0; i < NumBands; ++i )
+        deadBands[i] = ! audibleBands[i];
+    
+    dynamics.process(bandBlocks, resampledBands, deadBands);
+    
+    for ( size_t i = 0; i < NumBands; ++i )
+    {
+        if ( ! resampledBands[i] )
+            continue;
+        
+        processAsFloat(bandBlocks[i], [&](const juce::dsp::AudioBlock<float>& band)
+        {
+            if ( multirate && i == 0 )
+            {
+                if ( deadBands[i] )
+                    multirateLowBand.processDetector(band);
+                else
+                    multirateLowBand.processLowBand(band);
+            }
+            else
+            {
+                if ( deadBands[i] )
+                    oversampledCompressors[i].processDetector(band);
+                else
+                    oversampledCompressors[i].process(band);
+            }
+        });
+    }
+    
+    //a dead band is left uncompressed, it goes on as silence so it comes back from silence and not from stale audio
+    for ( size_t i = 0; i < NumBands; ++i )
+    {
+        if ( deadBands[i] )
+            bandBlocks[i].clear();
+    }
+    
+    path.bandAligner.process(bandBlocks);
+    
+    block.clear();
+    
+    for ( size_t i = 0; i < bandBlocks.size(); ++i )
+    {
+        if ( audibleBands[i] )
+            block.add(bandBlocks[i]);
+    }
+    
+    applyGain(block, path.outputGain);
+}
+
+void SkwiezorMBAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    if ( false )
+    {
+        buffer.clear();
+        auto block = juce::dsp::AudioBlock<float>(buffer);
+        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
+        osc.process(ctx);
+        
+        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
+        gain.process(ctx);
+    }
+    
+    processSamples(buffer);
+}
+
+void SkwiezorMBAudioProcessor::processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+{
+    processSamples(buffer);
+}
+
+template<typename SampleType>
+void SkwiezorMBAudioProcessor::processSamples(juce::AudioBuffer<SampleType>& buffer)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+    
+    // In case we have more outputs than inputs, this code clears any output
+    // channels that didn't contain input data, (because these aren't
+    // guaranteed to be empty - they may contain garbage).
+    // This is here to avoid people getting screaming feedback
+    // when they first compile a plugin, but obviously you don't need to keep
+    // this code if your algorithm always overwrites all the output channels.
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+    
+    if ( skipSilentBlock(buffer) )
+        return;
+    
+    updateState(buffer.getNumSamples());
+    
+    leftChannelFifo.update(buffer);
+    rightChannelFifo.update(buffer);
+    
+    auto bandsAreSoloed = false;
+    for ( auto& comp : compressors )
+    {
+        if ( comp.solo->get() )
+        {
+            bandsAreSoloed = true;
+            break;
+        }
+    }
+    
+    std::array<bool, NumBands> audibleBands;
+    for ( size_t i = 0; i < compressors.size(); ++i )
+    {
+        auto& comp = compressors[i];
+        audibleBands[i] = bandsAreSoloed ? comp.solo->get() && !comp.mute->get() : !comp.mute->get();
+    }
+    
+    //the band buffers are never resized here, a block larger than announced is just cut into more pieces
+    //a block in the precision prepareToPlay() did not see has no band buffers, hosts do not do that
+    jassert( scratchSize > 0 && buffer.getNumChannels() <= scratchChannels );
+    jassert( getPath<SampleType>().bandChannels[0][0] != nullptr );
+    
+    auto numSamples = buffer.getNumSamples();
+    auto numChannels = juce::jmin(buffer.getNumChannels(), scratchChannels);
+    auto chunkSize = useFusedEngine ? juce::jlimit(MinSubBlockSize, MaxSubBlockSize, subBlockSize.load()) : scratchSize;
+    chunkSize = juce::jmin(chunkSize, scratchSize);
+    
+    auto block = juce::dsp::AudioBlock<SampleType>(buffer).getSubsetChannelBlock(0, static_cast<size_t>(numChannels));
+    for ( int start = 0; start < numSamples; start += chunkSize )
+    {
+        auto length = juce::jmin(chunkSize, numSamples - start);
+        processChunk(block.getSubBlock(static_cast<size_t>(start), static_cast<size_t>(length)), audibleBands);
+    }
+    
+    publishLevels(audibleBands);
+}
+
+void SkwiezorMBAudioProcessor::publishLevels(const std::array<bool, NumBands>& audibleBands)
+{
+    //the compressors meter while they run, a band's levels come from whichever one ran it this block
+    for ( size_t i = 0; i < NumBands; ++i )
+    {
+        BandLevels levels;
+        if ( multirate && i == 0 )
+            levels = multirateLowBand.getLevels();
+        else if ( oversampledCompressors[i].isEnabled() )
+            levels = oversampledCompressors[i].getLevels();
+        else
+            levels = dynamics.getLevels(i);
+        
+        //a dead band only ran its detector, nothing of it reached the output
+        if ( ! audibleBands[i] )
+        {
+            levels.rmsOutput = levels.peakOutput = 0.f;
+            levels.minGain = levels.maxGain = 1.f;
+        }
+        
+        compressors[i].publishLevels(levels);
+        oversampledCompressors[i].resetLevels();
+    }
+    
+    multirateLowBand.resetLevels();
+    dynamics.resetLevels();
+}
+
+//==============================================================================
+bool SkwiezorMBAudioProcessor::hasEditor() const
+{
+    return true; // (change this to false if you choose to not supply an editor)
+}
+
+juce::AudioProcessorEditor* SkwiezorMBAudioProcessor::createEditor()
+{
+   #if SKWIEZOR_NUM_BANDS == 3
+    return new SkwiezorMBAudioProcessorEditor (*this);
+   #else
+    return new juce::GenericAudioProcessorEditor(*this);
+   #endif
+}
+
+//==============================================================================
+void SkwiezorMBAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
+{
+    // You should use this method to store your parameters in the memory block.
+    // You could do that either as raw data, or use the XML or ValueTree classes
+    // as intermediaries to make it easy to save and load complex data.
+    
+    juce::MemoryOutputStream mos(destData, true);
+    apvts.state.writeToStream(mos);
+}
+
+void SkwiezorMBAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
+{
+    // You should use this method to restore your parameters from this memory block,
+    // whose contents will have been created by the getStateInformation() call.
+    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+    if ( tree.isValid() )
+    {
+        apvts.replaceState(tree);
+        readCustomLinkGroups();
+    }
+}
+
+void SkwiezorMBAudioProcessor::setCustomLinkGroups(const ChannelLinks::Groups& groups)
+{
+    juce::StringArray numbers;
+    for ( auto group : groups )
+        numbers.add(juce::String(group));
+    
+    //stored with the parameters, so the groups come back with the session
+    apvts.state.setProperty(CustomLinkGroupsId, numbers.joinIntoString(" "), nullptr);
+    readCustomLinkGroups();
+}
+
+ChannelLinks::Groups SkwiezorMBAudioProcessor::getCustomLinkGroups() const
+{
+    ChannelLinks::Groups groups;
+    for ( size_t ch = 0; ch < MaxChannels; ++ch )
+        groups[ch] = customLinkGroups[ch].load(std::memory_order_relaxed);
+    
+    return groups;
+}
+
+void SkwiezorMBAudioProcessor::readCustomLinkGroups()
+{
+    //a state without the property (or from an older version) leaves every channel on its own
+    auto groups = ChannelLinks::getUnlinkedGroups();
+    auto numbers = juce::StringArray::fromTokens(apvts.state.getProperty(CustomLinkGroupsId).toString(), false);
+    for ( size_t ch = 0; ch < MaxChannels && static_cast<int>(ch) < numbers.size(); ++ch )
+        groups[ch] = numbers[static_cast<int>(ch)].getIntValue();
+    
+    for ( size_t ch = 0; ch < MaxChannels; ++ch )
+        customLinkGroups[ch].store(groups[ch], std::memory_order_relaxed);
+}
+
+juce::AudioProcessorValueTreeState::ParameterLayout SkwiezorMBAudioProcessor::createParameterLayout()
+{
+    APVTS::ParameterLayout layout;
+    
+    using namespace juce;
+    using namespace Params;
+    const auto& params = GetParams();
+    
+    auto attackReleaseRange = NormalisableRange<float>(0.1, 500, 0.1, 1);
+    auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
+    
+    const auto& choices = GetRatioChoices();
+    juce::StringArray sa;
+    for ( auto choice : choices)
+    {
+        sa.add( juce::String(choice, 1) );
+    }
+    
+    auto gainRange = NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f);
+    
+    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_In), 1}, params.at(Names::Gain_In), gainRange, 0));
+    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Gain_Out), 1}, params.at(Names::Gain_Out), gainRange, 0));
+    
+    //one parameter per band, in the same order as the hand written 3-band layout used to be
+    auto addBandParams = [&layout](BandParam param, auto makeParam)
+    {
+        for ( size_t band = 0; band < NumBands; ++band )
+        {
+            auto name = GetBandParamName(param, band);
+            layout.add(makeParam(juce::ParameterID{name, 1}, name));
+        }
+    };
+    
+    addBandParams(BandParam::Threshold, [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterFloat>(id, name, thresholdRange, 0); });
+    addBandParams(BandParam::Attack,    [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterFloat>(id, name, attackReleaseRange, 50); });
+    addBandParams(BandParam::Release,   [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterFloat>(id, name, attackReleaseRange, 250); });
+    addBandParams(BandParam::Ratio,     [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterChoice>(id, name, sa, 3); });
+    addBandParams(BandParam::Bypass,    [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterBool>(id, name, false); });
+    addBandParams(BandParam::Mute,      [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterBool>(id, name, false); });
+    addBandParams(BandParam::Solo,      [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterBool>(id, name, false); });
+    
+    const auto& crossoverRanges = GetCrossoverRanges();
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+    {
+        auto name = GetCrossoverParamName(i);
+        const auto& range = crossoverRanges[i];
+        layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{name, 1}, name, NormalisableRange<float>(range.minimum, range.maximum, 1, 1), range.defaultValue));
+    }
+    
+    for ( size_t i = 0; i < NumCrossovers; ++i )
+    {
+        auto name = GetCrossoverSlopeParamName(i);
+        layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{name, 1}, name, GetCrossoverSlopeChoices(), static_cast<int>(CrossoverSlope::LR4)));
+    }
+    
+    layout.add(std::make_unique<AudioParameterBool>(juce::ParameterID{params.at(Names::Linear_Phase), 1}, params.at(Names::Linear_Phase), false));
+    
+    addBandParams(BandParam::Oversampling, [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterChoice>(id, name, GetOversamplingChoices(), 0); });
+    
+    auto lookAheadRange = NormalisableRange<float>(0.f, MaxLookAheadMs, 0.1f, 1.f);
+    addBandParams(BandParam::LookAhead, [&](const auto& id, const auto& name) { return std::make_unique<AudioParameterFloat>(id, name, lookAheadRange, 0.f); });
+    
+    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Channel_Link), 1}, params.at(Names::Channel_Link), GetChannelLinkChoices(), 0));
+    layout.add(std::make_unique<AudioParameterChoice>(juce::ParameterID{params.at(Names::Link_Detector), 1}, params.at(Names::Link_Detector), GetLinkDetectorChoices(), static_cast<int>(LinkDetector::Max)));
+    layout.add(std::make_unique<AudioParameterFloat>(juce::ParameterID{params.at(Names::Link_Amount), 1}, params.at(Names::Link_Amount), NormalisableRange<float>(0.f, 100.f, 1.f, 1.f), 100.f));
+    
+    return layout;
+}
+
+//==============================================================================
+// This creates new instances of the plugin..
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
+{
+    return new SkwiezorMBAudioProcessor();
+}
@@ -1,99 +1,339 @@
-/*
-  ==============================================================================
-
-    This file contains the basic framework code for a JUCE plugin processor.
-
-  ==============================================================================
-*/
-
-#pragma once
-
-#include <JuceHeader.h>
-#include "DSP/CompressorBand.h"
-#include "DSP/SingleChannelSampleFifo.h"
-
-class SkwiezorMBAudioProcessor  : public juce::AudioProcessor
-{
-public:
-    //==============================================================================
-    SkwiezorMBAudioProcessor();
-    ~SkwiezorMBAudioProcessor() override;
-
-    //==============================================================================
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-
-   #ifndef JucePlugin_PreferredChannelConfigurations
-    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-   #endif
-
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
-
-    //==============================================================================
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
-
-    //==============================================================================
-    const juce::String getName() const override;
-
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
-
-    //==============================================================================
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
-
-    //==============================================================================
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
-    
-    using APVTS = juce::AudioProcessorValueTreeState;
-    static APVTS::ParameterLayout createParameterLayout();
-    
-    APVTS apvts {*this, nullptr, "Parameters", createParameterLayout()};
-    
-    using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
-
-    std::array<CompressorBand, 3> compressors;
-    CompressorBand& lowBandComp = compressors[0];
-    CompressorBand& midBandComp = compressors[1];
-    CompressorBand& highBandComp = compressors[2];
-private:
-    
-    using Filter = juce::dsp::LinkwitzRileyFilter<float>;
-    //      fc0     fc1
-    Filter  LP1,    AP2,
-            HP1,    LP2,
-                    HP2;
-    
-    juce::AudioParameterFloat* lowMidCrossover { nullptr };
-    juce::AudioParameterFloat* midHighCrossover { nullptr };
-    
-    std::array<juce::AudioBuffer<float>, 3> filterBuffers;
-    
-    juce::dsp::Gain<float> inputGain, outputGain;
-    juce::AudioParameterFloat* inputGainParam { nullptr };
-    juce::AudioParameterFloat* outputGainParam { nullptr };
-    
-    template<typename T, typename U>
-    void applyGain(T& buffer, U& gain)
-    {
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        gain.process(ctx);
-    }
-    void updateState();
-    void splitBands(const juce::AudioBuffer<float>& inputBuffer);
-    
-    juce::dsp::Oscillator<float> osc;
-    juce::dsp::Gain<float> gain;
-    //==============================================================================
-    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SkwiezorMBAudioProcessor)
-};
+/*
+  ==============================================================================
+
+    This file contains the basic framework code for a JUCE plugin processor.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "DSP/CompressorBand.h"
+#include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/ParamSnapshot.h"
+#include "DSP/Crossover.h"
+#include "DSP/LinearPhaseCrossover.h"
+#include "DSP/DynamicsKernel.h"
+#include "DSP/MultirateLowBand.h"
+#include "DSP/OversampledCompressor.h"
+#include "DSP/BandAligner.h"
+#include "DSP/ChannelLinks.h"
+#include "DSP/BufferArena.h"
+#include "DSP/Params.h"
+
+class SkwiezorMBAudioProcessor  : public juce::AudioProcessor
+{
+public:
+    //==============================================================================
+    SkwiezorMBAudioProcessor();
+    ~SkwiezorMBAudioProcessor() override;
+
+    //==============================================================================
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+
+   #ifndef JucePlugin_PreferredChannelConfigurations
+    bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
+   #endif
+
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    
+    /**
+     Hosts with a 64-bit bus get the whole chain in double: gains, crossover, compressors, alignment
+     and band sum. The resamplers (OversampledCompressor, MultirateLowBand) and the linear phase
+     convolution run in float and convert on the way in and out, detectors and meters are float anyway.
+     */
+    void processBlock (juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+
+    //==============================================================================
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    //==============================================================================
+    const juce::String getName() const override;
+
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    //==============================================================================
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    //==============================================================================
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+    
+    using APVTS = juce::AudioProcessorValueTreeState;
+    static APVTS::ParameterLayout createParameterLayout();
+    
+    APVTS apvts {*this, nullptr, "Parameters", createParameterLayout()};
+    
+    using BlockType = juce::AudioBuffer<float>;
+    SingleChannelSampleFifo<BlockType> leftChannelFifo { Channel::Left };
+    SingleChannelSampleFifo<BlockType> rightChannelFifo { Channel::Right };
+
+    //set with SKWIEZOR_NUM_BANDS, the custom editor needs 3 bands, other builds use the generic one
+    static constexpr size_t NumBands = Params::NumBands;
+    static constexpr size_t NumCrossovers = NumBands - 1;
+
+    std::array<CompressorBand, NumBands> compressors;
+    
+    /**
+     When true, processBlock() runs input gain -> split -> compressors -> band sum -> output gain
+     on one sub-block of subBlockSize samples at a time, so every intermediate stays in L1.
+     When false, every stage walks a whole prepared block (samplesPerBlock) before the next one starts.
+     Both paths run the same stages in the same order, so their output is identical
+     up to floating point contraction (well below 1e-6, i.e. -120 dBFS).
+     
+     Either way a host block is cut into pieces that fit the band buffers prepareToPlay() sized,
+     so blocks larger than announced are processed without allocating and at the same cost per sample.
+     */
+    std::atomic<bool> useFusedEngine { true };
+    
+    //clamped to [MinSubBlockSize, MaxSubBlockSize] and to the prepared block size
+    std::atomic<int> subBlockSize { 64 };
+    static constexpr int MinSubBlockSize = 16;
+    static constexpr int MaxSubBlockSize = 256;
+    
+    /**
+     When true, the low band is compressed at 1/2, 1/4 or 1/8 of the host rate (see MultirateLowBand)
+     and every band is delayed by the half-band round trip, which is added to the reported latency.
+     Has no effect below 44.1 kHz, or while the low cutoff is above MultirateLowBand::getMaxCutoff()
+     for its slope (about 1.8 kHz for LR4 at 44.1 kHz), where the band stays at the host rate.
+     */
+    std::atomic<bool> useMultirateLowBand { false };
+    
+    /**
+     How often (in samples) the compressors recompute their gain, 1 means every sample.
+     Larger intervals (8 to 32) ramp the gain in between, see DynamicsKernel::setControlInterval()
+     for the error bound. The resampled bands always compute it per sample.
+     */
+    std::atomic<int> gainControlInterval { 1 };
+    
+    /**
+     When true, once the input has been digital silence (every sample exactly 0) for as long as every
+     delay, filter and envelope needs to ring out below -150 dBFS (see getSilenceTimeoutSamples()),
+     processBlock() resets the DSP state and only clears the output until the input is back.
+     Quiet input, however far down, is always processed, so fades and reverb tails are never cut.
+     The first block that is not silent is processed as usual.
+     */
+    std::atomic<bool> useSilenceSkipping { true };
+    
+    //how many blocks processBlock() only cleared, since the instance was created, from any thread
+    uint64_t getNumSkippedBlocks() const { return numSkippedBlocks.load(std::memory_order_relaxed); }
+    
+    /**
+     Hibernation: once the instance has been idle (see useSilenceSkipping) for hibernateAfterSeconds,
+     or as soon as it is idle while the host's transport is stopped (if hibernateWhenStopped), a shared
+     background thread frees the band buffers, the analyzer FIFOs, the resampler arena, the look-ahead
+     lines and the linear phase kernels. Offline renders never hibernate.
+     The first block with input, or the first block after the transport starts, asks the same thread
+     to reserve them again; processBlock() never allocates or locks for it. Until that is done, which
+     takes a few blocks, the output stays cleared and the input is dropped, which is why only a
+     stopped transport hibernates by default: playback starting wakes the engine ahead of its input.
+     Input that arrives before the buffers were actually freed is processed right away, as usual.
+     releaseResources() frees the same buffers right away and prepareToPlay() reserves them.
+     0 or less never hibernates after a timeout.
+     */
+    std::atomic<double> hibernateAfterSeconds { 0.0 };
+    std::atomic<bool> hibernateWhenStopped { true };
+    
+    //bytes held by what hibernation frees, the parameters and the editor's analyzer are not counted
+    struct MemoryReport
+    {
+        size_t bandBuffers = 0;
+        size_t analyzerFifos = 0;
+        size_t resamplers = 0;
+        size_t lookAhead = 0;
+        size_t linearPhase = 0;
+        bool hibernating = false;
+        
+        size_t getTotal() const { return bandBuffers + analyzerFifos + resamplers + lookAhead + linearPhase; }
+    };
+    
+    //not from the audio thread, waits while the background thread is freeing or reserving
+    MemoryReport getMemoryReport() const;
+    
+    /**
+     The groups "Channel Link" uses when set to Custom: channels with the same number share a
+     detector, see ChannelLinks. Kept in the plugin state, message thread only.
+     */
+    void setCustomLinkGroups(const ChannelLinks::Groups& groups);
+    ChannelLinks::Groups getCustomLinkGroups() const;
+private:
+    
+    Crossover crossover;
+    LinearPhaseCrossover linearPhaseCrossover;
+    DynamicsKernel dynamics;
+    MultirateLowBand multirateLowBand;
+    bool multirate = false;
+    
+    //bands with oversampling on are compressed by their OversampledCompressor instead of dynamics
+    std::array<OversampledCompressor, NumBands> oversampledCompressors;
+    
+    //what they only need while one of them runs, sized for 8x once instead of once per band
+    OversampledCompressor::Workspace oversamplingWorkspace;
+    
+    //the band buffers and every resampler buffer, reserved in prepareToPlay()
+    BufferArena arena;
+    
+    //switching adds or removes the crossover's latency, so the host is told every time
+    juce::AudioParameterBool* linearPhaseParam { nullptr };
+    bool linearPhase = false;
+    
+    //set with the latency in updateLatency(), the host may ask from any thread
+    std::atomic<double> tailLengthSeconds { 0.0 };
+    
+    int64_t numSilentSamples = 0;
+    bool idle = false;
+    bool transportWasPlaying = false;
+    std::atomic<uint64_t> numSkippedBlocks { 0 };
+    
+    /**
+     Who owns the buffers hibernation frees: the audio thread while Awake, the background thread
+     from Freeing to Waking, nobody while Hibernating. Only the audio thread leaves Awake (for
+     Hibernating), and it asks for the buffers back by switching to Waking, or straight to Awake
+     from Hibernating, where nothing was freed yet. The background thread claims them by switching
+     Hibernating to Freeing, and hands them back by publishing Awake once it reserved them again.
+     */
+    enum class EngineState { Awake, Hibernating, Freeing, Hibernated, Waking };
+    std::atomic<EngineState> engineState { EngineState::Awake };
+    
+    //held by whoever frees or reserves the engine, never by the audio thread
+    juce::CriticalSection engineLock;
+    double preparedSampleRate = 0.0;
+    int preparedBlockSize = 0;
+    ProcessingPrecision preparedPrecision = singlePrecision;
+    size_t bandBufferBytes = 0;
+    
+    //one thread serves every instance, they are only polled for a state change
+    struct HibernationThread : juce::TimeSliceThread
+    {
+        HibernationThread() : juce::TimeSliceThread("Skwiezor hibernation") { startThread(); }
+        ~HibernationThread() override { stopThread(1000); }
+    };
+    
+    struct HibernationClient : juce::TimeSliceClient
+    {
+        explicit HibernationClient(SkwiezorMBAudioProcessor& o) : owner(o) { }
+        int useTimeSlice() override { return owner.updateHibernation(); }
+        
+        SkwiezorMBAudioProcessor& owner;
+    };
+    
+    juce::SharedResourcePointer<HibernationThread> hibernationThread;
+    HibernationClient hibernationClient { *this };
+    
+    std::array<juce::AudioParameterFloat*, NumCrossovers> crossoverFreqs {};
+    std::array<juce::AudioParameterChoice*, NumCrossovers> crossoverSlopeParams {};
+    
+    //any layout up to this many channels, see isBusesLayoutSupported()
+    static constexpr size_t MaxChannels = Params::MaxChannels;
+    
+    //what runs at the host's precision, the arena only holds buffers for the precision prepareEngine() saw
+    template<typename SampleType>
+    struct SignalPath
+    {
+        //planar slices at the front of the arena, band after band and channel after channel, so the
+        //crossover and the compressors stream through adjacent memory; processBlock() only uses parts of them
+        std::array<std::array<SampleType*, MaxChannels>, NumBands> bandChannels {};
+        BandAligner<NumBands, SampleType> bandAligner;
+        juce::dsp::Gain<SampleType> inputGain, outputGain;
+    };
+    
+    SignalPath<float> floatPath;
+    SignalPath<double> doublePath;
+    
+    template<typename SampleType>
+    SignalPath<SampleType>& getPath()
+    {
+        if constexpr ( std::is_same_v<SampleType, double> )
+            return doublePath;
+        else
+            return floatPath;
+    }
+    
+    template<typename Function>
+    void forEachPath(Function&& function)
+    {
+        function(floatPath);
+        function(doublePath);
+    }
+    
+    //the resamplers only take float, double bands pass through these slices (double precision only)
+    std::array<float*, MaxChannels> resamplerStaging {};
+    int scratchSize = 0;
+    int scratchChannels = 0;
+    
+    juce::AudioParameterFloat* inputGainParam { nullptr };
+    juce::AudioParameterFloat* outputGainParam { nullptr };
+    
+    //Off, the layout's mirrored pairs, every channel, or the custom groups
+    juce::AudioParameterChoice* channelLinkParam { nullptr };
+    
+    //what a linked group detects, and in % how far its channels detect it rather than themselves
+    juce::AudioParameterChoice* linkDetectorParam { nullptr };
+    juce::AudioParameterFloat* linkAmountParam { nullptr };
+    
+    //the mirrored pairs of the prepared layout, set by prepareEngine()
+    ChannelLinks::Groups layoutPairs = ChannelLinks::getUnlinkedGroups();
+    std::array<std::atomic<int>, MaxChannels> customLinkGroups;
+    static inline const juce::Identifier CustomLinkGroupsId { "customLinkGroups" };
+    void readCustomLinkGroups();
+    
+    ParamSnapshot<CrossoverSettings<NumBands>> crossoverSettings;
+    ParamSnapshot<Crossover::Slopes> crossoverSlopes;
+    ParamSnapshot<GainSettings> gainSettings;
+    ParamSnapshot<ChannelLinks::Groups> linkGroups;
+    ParamSnapshot<LinkSettings> linkSettings;
+    
+    template<typename SampleType>
+    void applyGain(juce::dsp::AudioBlock<SampleType>& block, juce::dsp::Gain<SampleType>& gain)
+    {
+        auto ctx = juce::dsp::ProcessContextReplacing<SampleType>(block);
+        gain.process(ctx);
+    }
+    //numSamples is the length of the coming block, automated crossovers glide over it
+    void updateState(int numSamples);
+    void updateLatency();
+    bool canUseMultirate() const;
+    int getSilenceTimeoutSamples() const;
+    template<typename SampleType>
+    bool skipSilentBlock(juce::AudioBuffer<SampleType>& buffer);
+    bool shouldHibernate();
+    bool isTransportPlaying();
+    //true if the engine can be used right away, otherwise the background thread reserves it
+    bool wakeEngine();
+    void prepareEngine(double sampleRate, int samplesPerBlock);
+    template<typename SampleType>
+    static size_t getPathArenaSize(const juce::dsp::ProcessSpec& spec, int maxBandLatency);
+    template<typename SampleType>
+    void preparePath(const juce::dsp::ProcessSpec& spec, int maxBandLatency);
+    void releaseEngine();
+    //on the background thread, returns the ms until the next call
+    int updateHibernation();
+    //both processBlock() overloads
+    template<typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType>& buffer);
+    template<typename SampleType>
+    void splitBands(const juce::dsp::AudioBlock<SampleType>& inputBlock);
+    template<typename SampleType>
+    void processChunk(juce::dsp::AudioBlock<SampleType> block, const std::array<bool, NumBands>& audibleBands);
+    template<typename SampleType, typename Function>
+    void processAsFloat(const juce::dsp::AudioBlock<SampleType>& band, Function&& process);
+    void publishLevels(const std::array<bool, NumBands>& audibleBands);
+    template<typename SampleType>
+    std::array<juce::dsp::AudioBlock<SampleType>, NumBands> getBandBlocks(size_t numChannels, size_t numSamples);
+    
+    juce::dsp::Oscillator<float> osc;
+    juce::dsp::Gain<float> gain;
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SkwiezorMBAudioProcessor)
+};
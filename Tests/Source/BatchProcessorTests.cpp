@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    BatchProcessorTests.cpp
+    Created: 18 Oct 2026 10:41:52am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../Source/DSP/BatchProcessor.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr size_t NumBands = SkwiezorMBAudioProcessor::NumBands;
+constexpr int BlockSize = 256;
+
+//the plugin's gains ramp in after prepareToPlay(), the batch starts at its targets
+constexpr int WarmUpSamples = static_cast<int>(SampleRate / 2.0);
+
+using Batch = BatchProcessor<4, NumBands>;
+
+//what the batch needs to run the chain processor runs, read from the processor's parameters
+Batch::Settings getStreamSettings(SkwiezorMBAudioProcessor& processor)
+{
+    using namespace Params;
+
+    auto get = [&](const juce::String& name) { return dynamic_cast<juce::AudioParameterFloat*>(processor.apvts.getParameter(name))->get(); };
+    auto getIndex = [&](const juce::String& name) { return dynamic_cast<juce::AudioParameterChoice*>(processor.apvts.getParameter(name))->getIndex(); };
+
+    Batch::Settings settings;
+    settings.gain = { get(GetParams().at(Names::Gain_In)), get(GetParams().at(Names::Gain_Out)) };
+
+    for ( size_t band = 0; band < NumBands; ++band )
+    {
+        auto ratioIndex = static_cast<size_t>(getIndex(GetBandParamName(BandParam::Ratio, band)));
+
+        settings.bands[band] = { get(GetBandParamName(BandParam::Attack, band)),
+                                 get(GetBandParamName(BandParam::Release, band)),
+                                 get(GetBandParamName(BandParam::Threshold, band)),
+                                 static_cast<float>(GetRatioChoices()[ratioIndex]),
+                                 false };
+    }
+
+    return settings;
+}
+}
+
+struct BatchProcessorTests : juce::UnitTest
+{
+    BatchProcessorTests() : juce::UnitTest("Batch processor", TestHelpers::CheckCategory) { }
+
+    void runTest() override
+    {
+        beginTest("every lane matches the plugin chain with its settings");
+
+        //two stereo stems with their own settings, four lanes
+        SkwiezorMBAudioProcessor compressing, gentle;
+        TestHelpers::setCompressing(compressing);
+        for ( size_t band = 0; band < NumBands; ++band )
+            TestHelpers::setBandParameter(gentle, Params::BandParam::Threshold, band, -12.f);
+
+        auto random = getRandom();
+        auto numSamples = static_cast<int>(SampleRate);
+        std::array<juce::AudioBuffer<float>, 2> stems { TestHelpers::makeProgramme(2, numSamples, SampleRate, random),
+                                                        TestHelpers::makeProgramme(2, numSamples, SampleRate, random) };
+
+        Batch batch;
+        batch.setStreamSettings(0, getStreamSettings(compressing));
+        batch.setStreamSettings(1, getStreamSettings(compressing));
+        batch.setStreamSettings(2, getStreamSettings(gentle));
+        batch.setStreamSettings(3, getStreamSettings(gentle));
+        batch.prepare(SampleRate);
+
+        std::array<float*, 4> streams { stems[0].getWritePointer(0), stems[0].getWritePointer(1),
+                                        stems[1].getWritePointer(0), stems[1].getWritePointer(1) };
+
+        auto input = stems;
+        auto expected = stems;
+        for ( auto* processor : { &compressing, &gentle } )
+        {
+            auto& stem = expected[processor == &compressing ? 0 : 1];
+            TestHelpers::prepare(*processor, SampleRate, BlockSize);
+            TestHelpers::processInBlocks(*processor, stem, BlockSize);
+        }
+
+        for ( int start = 0; start < numSamples; start += BlockSize )
+        {
+            auto length = juce::jmin(BlockSize, numSamples - start);
+
+            std::array<float*, 4> block;
+            for ( size_t stream = 0; stream < block.size(); ++stream )
+                block[stream] = streams[stream] + start;
+
+            batch.process(block.data(), block.size(), static_cast<size_t>(length));
+        }
+
+        for ( size_t stem = 0; stem < stems.size(); ++stem )
+        {
+            //both chains compress, a lane that ignored its settings could not match
+            expectGreaterThan(TestHelpers::getMaxDifference(input[stem], expected[stem], WarmUpSamples), 0.1f, "compression");
+            expectLessOrEqual(TestHelpers::getMaxDifference(stems[stem], expected[stem], WarmUpSamples), 1.0e-6f,
+                              "stem " + juce::String(static_cast<int>(stem)));
+        }
+    }
+};
+
+static BatchProcessorTests batchProcessorTests;
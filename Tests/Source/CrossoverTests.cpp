@@ -0,0 +1,422 @@
+/*
+  ==============================================================================
+
+    CrossoverTests.cpp
+    Created: 18 Oct 2026 10:03:17am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr size_t NumBands = Crossover::NumBands;
+constexpr size_t NumCrossovers = NumBands - 1;
+constexpr int NumChannels = 2;
+constexpr int BlockSize = 512;
+
+using Bands = std::array<juce::AudioBuffer<float>, NumBands>;
+
+Bands makeBands(int numSamples)
+{
+    Bands bands;
+    for ( auto& band : bands )
+        band.setSize(NumChannels, numSamples);
+
+    return bands;
+}
+
+//splits input into bands, BlockSize samples at a time
+void split(Crossover& crossover, juce::AudioBuffer<float>& input, Bands& bands)
+{
+    for ( int start = 0; start < input.getNumSamples(); start += BlockSize )
+    {
+        auto length = static_cast<size_t>(juce::jmin(BlockSize, input.getNumSamples() - start));
+        auto offset = static_cast<size_t>(start);
+
+        std::array<juce::dsp::AudioBlock<float>, NumBands> blocks;
+        for ( size_t band = 0; band < NumBands; ++band )
+            blocks[band] = juce::dsp::AudioBlock<float>(bands[band]).getSubBlock(offset, length);
+
+        crossover.process(juce::dsp::AudioBlock<float>(input).getSubBlock(offset, length), blocks);
+    }
+}
+
+//splits input like split(), moving the cutoffs before every block, each glide numRampSamples long (0 steps)
+void splitAutomated(Crossover& crossover, juce::AudioBuffer<float>& input, Bands& bands, int numRampSamples)
+{
+    auto cutoffs = Params::GetDefaultCrossoverFrequencies<NumBands>();
+
+    for ( int start = 0; start < input.getNumSamples(); start += BlockSize )
+    {
+        auto sweep = 1.f + 0.5f * std::sin(0.05f * static_cast<float>(start / BlockSize));
+
+        auto moved = cutoffs;
+        for ( auto& cutoff : moved )
+            cutoff *= sweep;
+        crossover.setCutoffFrequencies(moved, numRampSamples);
+
+        auto length = static_cast<size_t>(juce::jmin(BlockSize, input.getNumSamples() - start));
+        auto offset = static_cast<size_t>(start);
+
+        std::array<juce::dsp::AudioBlock<float>, NumBands> blocks;
+        for ( size_t band = 0; band < NumBands; ++band )
+            blocks[band] = juce::dsp::AudioBlock<float>(bands[band]).getSubBlock(offset, length);
+
+        crossover.process(juce::dsp::AudioBlock<float>(input).getSubBlock(offset, length), blocks);
+    }
+}
+
+juce::AudioBuffer<float> sumBands(const Bands& bands)
+{
+    auto sum = bands[0];
+    for ( size_t band = 1; band < NumBands; ++band )
+    {
+        for ( int ch = 0; ch < NumChannels; ++ch )
+            sum.addFrom(ch, 0, bands[band], ch, 0, sum.getNumSamples());
+    }
+
+    return sum;
+}
+
+/**
+ The plugin's original split, built from juce::dsp::LinkwitzRileyFilter (LR4): crossover i
+ splits what is above the crossovers below it, and every band below passes its allpass.
+ */
+struct ReferenceCrossover
+{
+    explicit ReferenceCrossover(const Crossover::Cutoffs& cutoffs)
+    {
+        juce::dsp::ProcessSpec spec { SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) };
+        using Type = juce::dsp::LinkwitzRileyFilterType;
+
+        for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+        {
+            auto setUp = [&](juce::dsp::LinkwitzRileyFilter<float>& filter, Type type)
+            {
+                filter.setType(type);
+                filter.prepare(spec);
+                filter.setCutoffFrequency(cutoffs[crossover]);
+            };
+
+            setUp(lowpasses[crossover], Type::lowpass);
+            setUp(highpasses[crossover], Type::highpass);
+
+            for ( auto& allpass : allpasses[crossover] )
+                setUp(allpass, Type::allpass);
+        }
+    }
+
+    void split(const juce::AudioBuffer<float>& input, Bands& bands)
+    {
+        auto rest = input;
+
+        for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+        {
+            bands[crossover].makeCopyOf(rest);
+            process(lowpasses[crossover], bands[crossover]);
+            process(highpasses[crossover], rest);
+
+            for ( size_t band = 0; band < crossover; ++band )
+                process(allpasses[crossover][band], bands[band]);
+        }
+
+        bands[NumCrossovers].makeCopyOf(rest);
+    }
+private:
+    static void process(juce::dsp::LinkwitzRileyFilter<float>& filter, juce::AudioBuffer<float>& buffer)
+    {
+        juce::dsp::AudioBlock<float> block(buffer);
+        filter.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+    std::array<juce::dsp::LinkwitzRileyFilter<float>, NumCrossovers> lowpasses, highpasses;
+    std::array<std::array<juce::dsp::LinkwitzRileyFilter<float>, NumCrossovers>, NumCrossovers> allpasses;
+};
+
+//what getGainDb() measures instead of a single band
+constexpr int BandSum = -1;
+
+//gain in dB of band (or of the band sum) for a sine at frequency, measured once the filters settled
+float getGainDb(Crossover& crossover, float frequency, int band = BandSum)
+{
+    auto numSamples = static_cast<int>(SampleRate / 2.0);
+    juce::AudioBuffer<float> sine(NumChannels, numSamples);
+
+    auto phaseStep = juce::MathConstants<double>::twoPi * frequency / SampleRate;
+    for ( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for ( int i = 0; i < numSamples; ++i )
+            sine.setSample(ch, i, static_cast<float>(0.5 * std::sin(phaseStep * i)));
+    }
+
+    crossover.reset();
+    auto bands = makeBands(numSamples);
+    split(crossover, sine, bands);
+    auto output = band == BandSum ? sumBands(bands) : bands[static_cast<size_t>(band)];
+
+    //over whole periods from the second half on, so the RMS of a sine is exact
+    auto period = SampleRate / frequency;
+    auto measureLength = static_cast<int>(std::floor(numSamples / 2 / period) * period);
+    auto measureStart = numSamples - measureLength;
+    auto gain = output.getRMSLevel(0, measureStart, measureLength) / sine.getRMSLevel(0, measureStart, measureLength);
+    return juce::Decibels::gainToDecibels(gain);
+}
+
+Crossover::Slopes makeSlopes(Params::CrossoverSlope slope)
+{
+    Crossover::Slopes slopes;
+    slopes.fill(slope);
+    return slopes;
+}
+
+juce::String getSlopeName(Params::CrossoverSlope slope)
+{
+    return Params::GetCrossoverSlopeChoices()[static_cast<int>(slope)];
+}
+
+//cutoffs spread evenly in log-frequency from 20 Hz to 0.46 fs, the highest a crossover gets (20 kHz at 44.1 kHz)
+std::vector<float> makeCutoffs(juce::Random& random, double sampleRate, int numCutoffs)
+{
+    auto octaves = std::log2(0.46 * sampleRate / 20.0);
+
+    std::vector<float> cutoffs(static_cast<size_t>(numCutoffs));
+    for ( auto& cutoff : cutoffs )
+        cutoff = static_cast<float>(20.0 * std::exp2(octaves * random.nextDouble()));
+
+    return cutoffs;
+}
+
+double getExactG(float cutoff, double sampleRate)
+{
+    return std::tan(juce::MathConstants<double>::pi * static_cast<double>(cutoff) / sampleRate);
+}
+
+constexpr std::array<Params::CrossoverSlope, 3> AllSlopes { Params::CrossoverSlope::LR2, Params::CrossoverSlope::LR4, Params::CrossoverSlope::LR8 };
+}
+
+struct CrossoverTests : juce::UnitTest
+{
+    CrossoverTests() : juce::UnitTest("Crossover", TestHelpers::CheckCategory) { }
+
+    void runTest() override
+    {
+        auto cutoffs = Params::GetDefaultCrossoverFrequencies<NumBands>();
+        juce::dsp::ProcessSpec spec { SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) };
+
+        Crossover crossover;
+        crossover.prepare(spec);
+        crossover.setCutoffFrequencies(cutoffs);
+
+        {
+            beginTest("coefficient table follows std::tan");
+
+            auto random = getRandom();
+            for ( auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 } )
+            {
+                CrossoverCoefficientTable table(sampleRate);
+
+                auto maxError = 0.0;
+                for ( auto cutoff : makeCutoffs(random, sampleRate, 100000) )
+                {
+                    auto exact = getExactG(cutoff, sampleRate);
+                    maxError = juce::jmax(maxError, std::abs(table.getG(cutoff) - exact) / exact);
+                }
+
+                expectLessOrEqual(maxError, 2.0e-7, "relative error at " + juce::String(static_cast<int>(sampleRate)) + " Hz");
+            }
+        }
+
+        {
+            beginTest("bands match juce::dsp::LinkwitzRileyFilter");
+
+            auto random = getRandom();
+            auto numSamples = static_cast<int>(SampleRate);
+            auto input = TestHelpers::makeProgramme(NumChannels, numSamples, SampleRate, random);
+
+            auto bands = makeBands(numSamples);
+            split(crossover, input, bands);
+
+            ReferenceCrossover reference(cutoffs);
+            auto referenceBands = makeBands(numSamples);
+            reference.split(input, referenceBands);
+
+            for ( size_t band = 0; band < NumBands; ++band )
+                expectLessOrEqual(TestHelpers::getMaxDifference(bands[band], referenceBands[band]), 1.0e-5f, "band " + juce::String(static_cast<int>(band)));
+
+            //and so does their sum, the input through the allpass of every crossover
+            expectLessOrEqual(TestHelpers::getMaxDifference(sumBands(bands), sumBands(referenceBands)), 1.0e-5f, "band sum");
+        }
+
+        {
+            beginTest("band sum is flat for every slope");
+
+            //every slope on its own, then a different one per crossover
+            std::vector<Crossover::Slopes> slopeSets;
+            for ( auto slope : AllSlopes )
+                slopeSets.push_back(makeSlopes(slope));
+
+            Crossover::Slopes mixed;
+            for ( size_t crossover = 0; crossover < NumCrossovers; ++crossover )
+                mixed[crossover] = AllSlopes[crossover % AllSlopes.size()];
+            slopeSets.push_back(mixed);
+
+            for ( const auto& slopes : slopeSets )
+            {
+                crossover.setSlopes(slopes);
+
+                juce::String name;
+                for ( auto slope : slopes )
+                    name << (name.isEmpty() ? "" : ", ") << getSlopeName(slope);
+
+                auto maxDeviation = 0.f;
+                for ( auto frequency = 20.f; frequency < 20000.f; frequency *= 1.5f )
+                    maxDeviation = juce::jmax(maxDeviation, std::abs(getGainDb(crossover, frequency)));
+
+                expectLessOrEqual(maxDeviation, 0.01f, name + ": dB from 20 Hz to 20 kHz");
+            }
+        }
+
+        {
+            beginTest("lowest band falls off at the slope's rate");
+
+            //12, 24 and 48 dB/oct reach 2 octaves above the cutoff at -24, -48 and -96 dB, give or take 3 dB
+            std::array<float, AllSlopes.size()> limits { -21.f, -45.f, -93.f };
+
+            for ( size_t i = 0; i < AllSlopes.size(); ++i )
+            {
+                crossover.setSlopes(makeSlopes(AllSlopes[i]));
+                expectLessOrEqual(getGainDb(crossover, 4.f * cutoffs[0], 0), limits[i], getSlopeName(AllSlopes[i]) + " at 4x the cutoff");
+            }
+
+            crossover.setSlopes(makeSlopes(Params::CrossoverSlope::LR4));
+        }
+
+        {
+            beginTest("a glide ends on the filter a step sets");
+
+            auto random = getRandom();
+            auto numSamples = static_cast<int>(SampleRate);
+            auto input = TestHelpers::makeProgramme(NumChannels, numSamples, SampleRate, random);
+
+            //automation for the first half, the same cutoffs held for the second
+            auto half = numSamples / 2 / BlockSize * BlockSize;
+            juce::AudioBuffer<float> automated(input.getArrayOfWritePointers(), NumChannels, 0, half);
+            juce::AudioBuffer<float> held(input.getArrayOfWritePointers(), NumChannels, half, numSamples - half);
+
+            std::array<Bands, 2> results;
+            for ( auto glide : { false, true } )
+            {
+                Crossover automatedCrossover;
+                automatedCrossover.prepare(spec);
+
+                auto& bands = results[glide ? 1 : 0];
+                bands = makeBands(numSamples);
+
+                auto automatedBands = makeBands(half);
+                splitAutomated(automatedCrossover, automated, automatedBands, glide ? BlockSize : 0);
+
+                auto heldBands = makeBands(numSamples - half);
+                split(automatedCrossover, held, heldBands);
+
+                for ( size_t band = 0; band < NumBands; ++band )
+                {
+                    for ( int ch = 0; ch < NumChannels; ++ch )
+                    {
+                        bands[band].copyFrom(ch, 0, automatedBands[band], ch, 0, half);
+                        bands[band].copyFrom(ch, half, heldBands[band], ch, 0, numSamples - half);
+                    }
+                }
+            }
+
+            //they differ while the cutoffs move, and once the states have decayed, not at all
+            for ( size_t band = 0; band < NumBands; ++band )
+            {
+                auto name = "band " + juce::String(static_cast<int>(band));
+                expectGreaterThan(TestHelpers::getMaxDifference(results[0][band], results[1][band]), 1.0e-4f, name + " while moving");
+                expectEquals(TestHelpers::getMaxDifference(results[0][band], results[1][band], numSamples - numSamples / 4), 0.f, name + " held");
+            }
+        }
+    }
+};
+
+static CrossoverTests crossoverTests;
+
+//cost per sample of a stereo split for each slope, every crossover at that slope
+struct CrossoverBenchmark : juce::UnitTest
+{
+    CrossoverBenchmark() : juce::UnitTest("Crossover", TestHelpers::BenchmarkCategory) { }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        auto numSamples = static_cast<int>(SampleRate);
+        auto input = TestHelpers::makeProgramme(NumChannels, numSamples, SampleRate, random);
+        auto bands = makeBands(numSamples);
+
+        beginTest("ns per sample");
+
+        juce::dsp::ProcessSpec spec { SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) };
+
+        for ( auto slope : AllSlopes )
+        {
+            Crossover crossover;
+            crossover.prepare(spec);
+            crossover.setCutoffFrequencies(Params::GetDefaultCrossoverFrequencies<NumBands>());
+            crossover.setSlopes(makeSlopes(slope));
+
+            auto nanoseconds = TestHelpers::measureNanosecondsPerSample(numSamples, 5, [&] { split(crossover, input, bands); });
+            logMessage(getSlopeName(slope) + ": " + juce::String(nanoseconds, 1) + " ns, " + juce::String(static_cast<int>(NumBands)) + " bands");
+        }
+
+        beginTest("automated cutoffs, ns per sample");
+
+        //static, then new cutoffs before every block, stepped or gliding over it
+        std::array<double, 3> nanoseconds {};
+        for ( size_t i = 0; i < nanoseconds.size(); ++i )
+        {
+            Crossover crossover;
+            crossover.prepare(spec);
+            crossover.setCutoffFrequencies(Params::GetDefaultCrossoverFrequencies<NumBands>());
+
+            nanoseconds[i] = TestHelpers::measureNanosecondsPerSample(numSamples, 5, [&]
+            {
+                if ( i == 0 )
+                    split(crossover, input, bands);
+                else
+                    splitAutomated(crossover, input, bands, i == 2 ? BlockSize : 0);
+            });
+        }
+
+        logMessage("static: " + juce::String(nanoseconds[0], 1) + " ns, stepped every block: " + juce::String(nanoseconds[1], 1)
+                   + " ns (" + juce::String(nanoseconds[1] / nanoseconds[0], 2) + "x), gliding every block: "
+                   + juce::String(nanoseconds[2], 1) + " ns (" + juce::String(nanoseconds[2] / nanoseconds[0], 2) + "x)");
+
+        beginTest("coefficient table, ns per cutoff");
+
+        constexpr int NumCutoffs = 100000;
+        auto cutoffs = makeCutoffs(random, SampleRate, NumCutoffs);
+        std::vector<double> gs(cutoffs.size());
+        CrossoverCoefficientTable table(SampleRate);
+
+        auto tableTime = TestHelpers::measureNanosecondsPerSample(NumCutoffs, 5, [&]
+        {
+            for ( size_t i = 0; i < cutoffs.size(); ++i )
+                gs[i] = table.getG(cutoffs[i]);
+        });
+
+        auto tanTime = TestHelpers::measureNanosecondsPerSample(NumCutoffs, 5, [&]
+        {
+            for ( size_t i = 0; i < cutoffs.size(); ++i )
+                gs[i] = getExactG(cutoffs[i], SampleRate);
+        });
+
+        logMessage("table: " + juce::String(tableTime, 1) + " ns, std::tan: " + juce::String(tanTime, 1)
+                   + " ns (" + juce::String(tanTime / tableTime, 2) + "x)");
+    }
+};
+
+static CrossoverBenchmark crossoverBenchmark;
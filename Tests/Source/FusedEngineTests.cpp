@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    FusedEngineTests.cpp
+    Created: 18 Oct 2026 9:12:40am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr int NumChannels = 2;
+
+//the output of the whole chain for the test programme, with the fused engine on or off
+juce::AudioBuffer<float> render(bool fused, int blockSize, const juce::AudioBuffer<float>& programme)
+{
+    SkwiezorMBAudioProcessor processor;
+    processor.useFusedEngine = fused;
+    TestHelpers::setCompressing(processor);
+    TestHelpers::prepare(processor, SampleRate, blockSize);
+
+    auto buffer = programme;
+    TestHelpers::processInBlocks(processor, buffer, blockSize);
+    return buffer;
+}
+}
+
+struct FusedEngineTests : juce::UnitTest
+{
+    FusedEngineTests() : juce::UnitTest("Fused engine", TestHelpers::CheckCategory) { }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        auto programme = TestHelpers::makeProgramme(NumChannels, static_cast<int>(SampleRate), SampleRate, random);
+
+        //the documented tolerance of useFusedEngine
+        constexpr float Tolerance = 1.0e-6f;
+
+        for ( auto blockSize : { 64, 256, 1000, 1024 } )
+        {
+            beginTest("fused and unfused output, blocks of " + juce::String(blockSize));
+
+            auto fused = render(true, blockSize, programme);
+            auto unfused = render(false, blockSize, programme);
+
+            expectLessOrEqual(TestHelpers::getMaxDifference(fused, unfused), Tolerance);
+        }
+    }
+};
+
+static FusedEngineTests fusedEngineTests;
+
+/**
+ Cost per sample of both engines, timed. Next to it an estimate, not a measurement, of how much
+ band buffer each stage streams through before the next one starts, worked out from the buffer
+ sizes: the whole block unfused, one sub-block fused.
+ */
+struct FusedEngineBenchmark : juce::UnitTest
+{
+    FusedEngineBenchmark() : juce::UnitTest("Fused engine", TestHelpers::BenchmarkCategory) { }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        auto numSamples = static_cast<int>(SampleRate);
+        auto programme = TestHelpers::makeProgramme(NumChannels, numSamples, SampleRate, random);
+
+        beginTest("ns per sample");
+
+        for ( auto blockSize : { 64, 256, 1024 } )
+        {
+            std::array<double, 2> nanoseconds {};
+            auto subBlockSize = blockSize;
+
+            for ( auto fused : { false, true } )
+            {
+                SkwiezorMBAudioProcessor processor;
+                processor.useFusedEngine = fused;
+                TestHelpers::setCompressing(processor);
+                TestHelpers::prepare(processor, SampleRate, blockSize);
+
+                if ( fused )
+                    subBlockSize = juce::jmin(blockSize, processor.subBlockSize.load());
+
+                auto buffer = programme;
+                nanoseconds[fused ? 1 : 0] = TestHelpers::measureNanosecondsPerSample(numSamples, 5, [&]
+                {
+                    buffer.makeCopyOf(programme);
+                    TestHelpers::processInBlocks(processor, buffer, blockSize);
+                });
+            }
+
+            //bands x channels x samples x 4 bytes, what the stages touch if nothing else does
+            auto bandBytes = [&](int samples)
+            {
+                return static_cast<int>(SkwiezorMBAudioProcessor::NumBands) * NumChannels * samples * static_cast<int>(sizeof(float));
+            };
+
+            logMessage("block " + juce::String(blockSize)
+                       + ": unfused " + juce::String(nanoseconds[0], 1) + " ns, fused " + juce::String(nanoseconds[1], 1)
+                       + " ns (" + juce::String(nanoseconds[0] / nanoseconds[1], 2) + "x), estimated band buffers per stage "
+                       + juce::String(bandBytes(blockSize) / 1024.0, 1) + " KB unfused, "
+                       + juce::String(bandBytes(subBlockSize) / 1024.0, 1) + " KB fused");
+        }
+    }
+};
+
+static FusedEngineBenchmark fusedEngineBenchmark;
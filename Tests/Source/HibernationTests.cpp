@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    HibernationTests.cpp
+    Created: 18 Oct 2026 4:37:15pm
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include <new>
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr int NumChannels = 2;
+constexpr int BlockSize = 256;
+
+//only allocations of the thread that set it are counted, the background threads are free to allocate
+thread_local bool countsAllocations = false;
+std::atomic<int> numAllocations { 0 };
+
+void* allocate(std::size_t size)
+{
+    if ( countsAllocations )
+        numAllocations.fetch_add(1);
+
+    if ( auto* memory = std::malloc(size == 0 ? 1 : size) )
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void* allocateAligned(std::size_t size, std::size_t alignment)
+{
+    if ( countsAllocations )
+        numAllocations.fetch_add(1);
+
+    void* memory = nullptr;
+    if ( posix_memalign(&memory, juce::jmax(alignment, sizeof(void*)), size == 0 ? 1 : size) == 0 )
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+//processes one block of buffer in place, counting what processBlock() allocates
+int processCountingAllocations(SkwiezorMBAudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    numAllocations.store(0);
+    countsAllocations = true;
+    processor.processBlock(buffer, midi);
+    countsAllocations = false;
+
+    return numAllocations.load();
+}
+}
+
+void* operator new(std::size_t size) { return allocate(size); }
+void* operator new[](std::size_t size) { return allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return allocateAligned(size, static_cast<std::size_t>(alignment)); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return allocateAligned(size, static_cast<std::size_t>(alignment)); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+
+struct HibernationTests : juce::UnitTest
+{
+    HibernationTests() : juce::UnitTest("Hibernation", TestHelpers::CheckCategory) { }
+
+    void runTest() override
+    {
+        beginTest("waking a hibernated instance does not allocate in processBlock()");
+
+        SkwiezorMBAudioProcessor processor;
+        TestHelpers::setCompressing(processor);
+        processor.hibernateAfterSeconds = 0.1;
+        TestHelpers::prepare(processor, SampleRate, BlockSize);
+
+        juce::AudioBuffer<float> buffer(NumChannels, BlockSize);
+        juce::MidiBuffer midi;
+
+        //silence until everything has rung out, then for hibernateAfterSeconds, then the background thread frees the engine
+        auto hibernated = [&processor]
+        {
+            auto report = processor.getMemoryReport();
+            return report.hibernating && report.getTotal() == 0;
+        };
+
+        auto allocations = 0;
+        for ( int i = 0; i < 5000 && ! hibernated(); ++i )
+        {
+            buffer.clear();
+            allocations += processCountingAllocations(processor, buffer, midi);
+
+            if ( processor.getMemoryReport().hibernating )
+                juce::Thread::sleep(5);
+        }
+
+        expect(hibernated(), "hibernated");
+        expectEquals(allocations, 0, "while going idle");
+
+        //input asks for the engine back, the output stays cleared until the background thread reserved it
+        auto random = getRandom();
+        auto woke = false;
+        allocations = 0;
+        for ( int i = 0; i < 200 && ! woke; ++i )
+        {
+            for ( int ch = 0; ch < NumChannels; ++ch )
+            {
+                for ( int n = 0; n < BlockSize; ++n )
+                    buffer.setSample(ch, n, 0.2f * (random.nextFloat() - 0.5f));
+            }
+
+            allocations += processCountingAllocations(processor, buffer, midi);
+            woke = buffer.getMagnitude(0, BlockSize) > 0.f;
+
+            juce::Thread::sleep(5);
+        }
+
+        expect(woke, "woke up");
+        expectEquals(allocations, 0, "while waking");
+
+        auto report = processor.getMemoryReport();
+        expect(! report.hibernating && report.bandBuffers > 0, "reserved again");
+    }
+};
+
+static HibernationTests hibernationTests;
@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+
+    LatencyTests.cpp
+    Created: 18 Oct 2026 11:26:08am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include "TestHelpers.h"
+#include "../../Source/DSP/LinearPhaseCrossover.h"
+
+namespace
+{
+constexpr double SampleRate = 48000.0;
+constexpr size_t NumBands = SkwiezorMBAudioProcessor::NumBands;
+constexpr int NumChannels = 2;
+constexpr int BlockSize = 256;
+
+//the plugin's gains ramp in after prepareToPlay(), its output is only compared from then on
+int getWarmUpSamples(double sampleRate = SampleRate)
+{
+    return static_cast<int>(sampleRate / 10.0);
+}
+
+//noise at -20 dBFS, nothing in it lines up with a delayed copy of itself
+juce::AudioBuffer<float> makeNoise(int numSamples, juce::Random& random)
+{
+    juce::AudioBuffer<float> buffer(NumChannels, numSamples);
+
+    for ( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for ( int i = 0; i < numSamples; ++i )
+            buffer.setSample(ch, i, 0.2f * (random.nextFloat() - 0.5f));
+    }
+
+    return buffer;
+}
+
+//sines at -26 dBFS each, all well inside the band the resamplers pass untouched
+juce::AudioBuffer<float> makeTones(int numSamples)
+{
+    juce::AudioBuffer<float> buffer(NumChannels, numSamples);
+
+    for ( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for ( int i = 0; i < numSamples; ++i )
+        {
+            auto sample = 0.0;
+            for ( auto frequency : { 110.0, 1030.0, 5100.0, 12300.0 } )
+                sample += 0.05 * std::sin(juce::MathConstants<double>::twoPi * frequency * (i + ch) / SampleRate);
+
+            buffer.setSample(ch, i, static_cast<float>(sample));
+        }
+    }
+
+    return buffer;
+}
+
+//a sine at -6 dBFS
+juce::AudioBuffer<float> makeSine(int numSamples, double frequency, double sampleRate)
+{
+    juce::AudioBuffer<float> buffer(NumChannels, numSamples);
+
+    for ( int ch = 0; ch < NumChannels; ++ch )
+    {
+        for ( int i = 0; i < numSamples; ++i )
+            buffer.setSample(ch, i, static_cast<float>(0.5 * std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate)));
+    }
+
+    return buffer;
+}
+
+//RMS level of the first channel over numSamples from startSample on, in dB
+float getLevelDb(const juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
+{
+    return juce::Decibels::gainToDecibels(buffer.getRMSLevel(0, startSample, numSamples));
+}
+
+void setOversampling(SkwiezorMBAudioProcessor& processor, int choice)
+{
+    for ( size_t band = 0; band < NumBands; ++band )
+        TestHelpers::setBandChoice(processor, Params::BandParam::Oversampling, band, choice);
+}
+
+//every ratio 1:1 and the gains at 0 dB, so the chain only splits, delays and sums
+void setTransparent(SkwiezorMBAudioProcessor& processor)
+{
+    for ( size_t band = 0; band < NumBands; ++band )
+        TestHelpers::setBandChoice(processor, Params::BandParam::Ratio, band, 0);
+}
+
+struct Render
+{
+    juce::AudioBuffer<float> output;
+    int reportedLatency = 0;
+};
+
+Render render(SkwiezorMBAudioProcessor& processor, const juce::AudioBuffer<float>& input, double sampleRate = SampleRate)
+{
+    TestHelpers::prepare(processor, sampleRate, BlockSize);
+
+    //the host reads the latency right after prepareToPlay(), before any block
+    Render result;
+    result.reportedLatency = processor.getLatencySamples();
+    result.output = input;
+    TestHelpers::processInBlocks(processor, result.output, BlockSize);
+    return result;
+}
+
+//the delay of delayed against reference, searched up to twice expectedDelay
+int measureDelay(const juce::AudioBuffer<float>& reference, const juce::AudioBuffer<float>& delayed, int expectedDelay)
+{
+    auto correlationLength = juce::jmin(reference.getNumSamples() / 2, 8192);
+    return TestHelpers::findDelay(reference.getReadPointer(0), delayed.getReadPointer(0),
+                                  correlationLength + 2 * expectedDelay, 2 * expectedDelay + 64);
+}
+
+//the first block boundary from the middle of the input on
+int getChangePosition(int numSamples)
+{
+    return (numSamples / 2 + BlockSize - 1) / BlockSize * BlockSize;
+}
+
+using LinearPhaseBands = std::array<juce::AudioBuffer<float>, NumBands>;
+
+/**
+ Splits input with crossover, BlockSize samples at a time. If newCutoffs is set, they are
+ handed to the crossover halfway through, and the builder thread gets the time to build them.
+ */
+LinearPhaseBands splitLinearPhase(LinearPhaseCrossover& crossover, const juce::AudioBuffer<float>& input,
+                                  const LinearPhaseCrossover::Cutoffs* newCutoffs)
+{
+    auto numSamples = input.getNumSamples();
+
+    LinearPhaseBands bands;
+    for ( auto& band : bands )
+        band.setSize(NumChannels, numSamples);
+
+    auto in = input;
+    for ( int start = 0; start < numSamples; start += BlockSize )
+    {
+        if ( newCutoffs != nullptr && start == getChangePosition(numSamples) )
+        {
+            crossover.setCutoffFrequencies(*newCutoffs);
+            juce::Thread::sleep(100);
+        }
+
+        auto length = static_cast<size_t>(juce::jmin(BlockSize, numSamples - start));
+        auto offset = static_cast<size_t>(start);
+
+        std::array<juce::dsp::AudioBlock<float>, NumBands> blocks;
+        for ( size_t band = 0; band < NumBands; ++band )
+            blocks[band] = juce::dsp::AudioBlock<float>(bands[band]).getSubBlock(offset, length);
+
+        crossover.process(juce::dsp::AudioBlock<float>(in).getSubBlock(offset, length), blocks);
+    }
+
+    return bands;
+}
+}
+
+struct LatencyTests : juce::UnitTest
+{
+    LatencyTests() : juce::UnitTest("Latency", TestHelpers::CheckCategory) { }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        auto numSamples = static_cast<int>(SampleRate);
+        auto noise = makeNoise(numSamples, random);
+
+        {
+            beginTest("linear phase bands sum to the delayed input, across a cutoff change");
+
+            juce::dsp::ProcessSpec spec { SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) };
+            auto cutoffs = Params::GetDefaultCrossoverFrequencies<NumBands>();
+
+            LinearPhaseCrossover unchanged, changed;
+            unchanged.prepare(spec, cutoffs, true);
+            changed.prepare(spec, cutoffs, true);
+
+            auto newCutoffs = cutoffs;
+            for ( auto& cutoff : newCutoffs )
+                cutoff *= 1.5f;
+
+            auto reference = splitLinearPhase(unchanged, noise, nullptr);
+            auto bands = splitLinearPhase(changed, noise, &newCutoffs);
+
+            auto sum = bands[0];
+            for ( size_t band = 1; band < NumBands; ++band )
+            {
+                for ( int ch = 0; ch < NumChannels; ++ch )
+                    sum.addFrom(ch, 0, bands[band], ch, 0, numSamples);
+            }
+
+            auto latency = changed.getLatencySamples();
+            expectLessOrEqual(TestHelpers::getMaxDifference(noise, sum, 0, latency), 1.0e-5f, "band sum");
+
+            //and the new kernels did take over
+            expectGreaterThan(TestHelpers::getMaxDifference(bands[0], reference[0], getChangePosition(numSamples) + latency), 0.01f, "after the change");
+        }
+
+        {
+            beginTest("linear phase output is the input delayed by the reported latency");
+
+            SkwiezorMBAudioProcessor processor;
+            setTransparent(processor);
+            TestHelpers::setParameter<juce::AudioParameterBool>(processor, Params::GetParams().at(Params::Names::Linear_Phase), true);
+
+            auto result = render(processor, noise);
+            expectGreaterThan(result.reportedLatency, 0, "reported");
+            expectEquals(measureDelay(noise, result.output, result.reportedLatency), result.reportedLatency, "measured");
+            expectLessOrEqual(TestHelpers::getMaxDifference(noise, result.output, getWarmUpSamples(), result.reportedLatency), 1.0e-5f, "output");
+        }
+
+        {
+            beginTest("linear phase kernels are only allocated once it is switched on");
+
+            SkwiezorMBAudioProcessor processor;
+            setTransparent(processor);
+            TestHelpers::prepare(processor, SampleRate, BlockSize);
+
+            auto iirLatency = processor.getLatencySamples();
+            expectEquals(static_cast<int>(processor.getMemoryReport().linearPhase), 0, "switched off");
+
+            TestHelpers::setParameter<juce::AudioParameterBool>(processor, Params::GetParams().at(Params::Names::Linear_Phase), true);
+
+            //the IIR crossover carries on until the background thread has built them
+            auto block = makeNoise(BlockSize, random);
+            for ( int i = 0; i < 100 && processor.getLatencySamples() == iirLatency; ++i )
+            {
+                TestHelpers::processInBlocks(processor, block, BlockSize);
+                juce::Thread::sleep(10);
+            }
+
+            LinearPhaseCrossover reference;
+            reference.prepare({ SampleRate, static_cast<juce::uint32>(BlockSize), static_cast<juce::uint32>(NumChannels) },
+                              Params::GetDefaultCrossoverFrequencies<NumBands>(), false);
+
+            expect(processor.getMemoryReport().linearPhase > 0, "switched on");
+            expectEquals(processor.getLatencySamples() - iirLatency, reference.getLatencySamples(), "latency");
+        }
+
+        for ( auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 } )
+        {
+            beginTest("multirate low band is the host rate output delayed by the reported latency, "
+                      + juce::String(static_cast<int>(sampleRate)) + " Hz");
+
+            //the band sum keeps the crossover's allpass response, so the reference is the plugin with multirate off
+            std::array<Render, 2> results;
+            for ( auto multirate : { false, true } )
+            {
+                SkwiezorMBAudioProcessor processor;
+                processor.useMultirateLowBand = multirate;
+                setTransparent(processor);
+                results[multirate ? 1 : 0] = render(processor, noise, sampleRate);
+            }
+
+            auto& [hostRate, multirate] = results;
+            auto latency = multirate.reportedLatency - hostRate.reportedLatency;
+
+            expectGreaterThan(latency, 0, "reported");
+            expectEquals(measureDelay(hostRate.output, multirate.output, latency), latency, "measured");
+            expectLessOrEqual(TestHelpers::getMaxDifference(hostRate.output, multirate.output, getWarmUpSamples(sampleRate), latency), 2.0e-4f, "output");
+        }
+
+        auto tones = makeTones(numSamples);
+
+        for ( int choice = 1; choice < Params::GetOversamplingChoices().size(); ++choice )
+        {
+            beginTest("oversampled bands are the host rate output delayed by the reported latency, "
+                      + Params::GetOversamplingChoices()[choice]);
+
+            auto renderBoth = [&](const juce::AudioBuffer<float>& input)
+            {
+                std::array<Render, 2> results;
+                for ( auto oversampled : { false, true } )
+                {
+                    SkwiezorMBAudioProcessor processor;
+                    setTransparent(processor);
+                    setOversampling(processor, oversampled ? choice : 0);
+                    results[oversampled ? 1 : 0] = render(processor, input);
+                }
+
+                return results;
+            };
+
+            auto noiseResults = renderBoth(noise);
+            auto latency = noiseResults[1].reportedLatency - noiseResults[0].reportedLatency;
+
+            expectEquals(latency, OversampledCompressor::getLatencySamples(choice), "reported");
+            expectEquals(measureDelay(noiseResults[0].output, noiseResults[1].output, latency), latency, "measured");
+
+            //noise reaches past the resamplers' passband, the tones do not
+            auto toneResults = renderBoth(tones);
+            expectLessOrEqual(TestHelpers::getMaxDifference(toneResults[0].output, toneResults[1].output, getWarmUpSamples(), latency),
+                              1.0e-4f, "output of the tones");
+        }
+
+        for ( auto frequency : { 18000.0, 19000.0, 20000.0 } )
+        {
+            beginTest("oversampled bands keep the level of a " + juce::String(static_cast<int>(frequency / 1000.0))
+                      + " kHz tone at 44.1 kHz");
+
+            //the first stage's half-band has to pass the top of the host band, not only the tones above
+            constexpr double HostRate = 44100.0;
+            auto length = static_cast<int>(HostRate / 2.0);
+            auto window = length - getWarmUpSamples(HostRate) - 2 * BlockSize;
+            auto sine = makeSine(length, frequency, HostRate);
+
+            auto hostRateLevel = 0.f;
+            for ( int choice = 0; choice < Params::GetOversamplingChoices().size(); ++choice )
+            {
+                SkwiezorMBAudioProcessor processor;
+                setTransparent(processor);
+                setOversampling(processor, choice);
+
+                auto result = render(processor, sine, HostRate);
+                auto level = getLevelDb(result.output, getWarmUpSamples(HostRate) + result.reportedLatency, window);
+
+                if ( choice == 0 )
+                    hostRateLevel = level;
+                else
+                    expectWithinAbsoluteError(level, hostRateLevel, 0.01f, Params::GetOversamplingChoices()[choice]);
+            }
+        }
+
+        {
+            beginTest("look-ahead bands are the output without it delayed by the reported latency");
+
+            //a different look-ahead per band, the aligner delays the others to the longest
+            std::array<Render, 2> results;
+            auto longest = 0.f;
+            for ( auto lookAhead : { false, true } )
+            {
+                SkwiezorMBAudioProcessor processor;
+                setTransparent(processor);
+
+                for ( size_t band = 0; lookAhead && band < NumBands; ++band )
+                {
+                    auto ms = Params::MaxLookAheadMs * static_cast<float>(band + 1) / static_cast<float>(NumBands);
+                    TestHelpers::setBandParameter(processor, Params::BandParam::LookAhead, band, ms);
+                    longest = juce::jmax(longest, ms);
+                }
+
+                results[lookAhead ? 1 : 0] = render(processor, noise);
+            }
+
+            auto latency = results[1].reportedLatency - results[0].reportedLatency;
+
+            expectEquals(latency, DynamicsKernel::lookAheadToSamples(longest, SampleRate), "reported");
+            expectEquals(measureDelay(results[0].output, results[1].output, latency), latency, "measured");
+            expectLessOrEqual(TestHelpers::getMaxDifference(results[0].output, results[1].output, getWarmUpSamples(), latency), 1.0e-6f, "output");
+        }
+    }
+};
+
+static LatencyTests latencyTests;
+
+/**
+ Cost per sample of the whole chain with every band oversampled at each factor, against the
+ chain at the host rate, and the resampler workspace they share.
+ */
+struct OversamplingBenchmark : juce::UnitTest
+{
+    OversamplingBenchmark() : juce::UnitTest("Oversampling", TestHelpers::BenchmarkCategory) { }
+
+    void runTest() override
+    {
+        auto random = getRandom();
+        auto numSamples = static_cast<int>(SampleRate);
+        auto programme = TestHelpers::makeProgramme(NumChannels, numSamples, SampleRate, random);
+
+        beginTest("ns per sample");
+
+        auto hostRate = 0.0;
+        for ( int choice = 0; choice < Params::GetOversamplingChoices().size(); ++choice )
+        {
+            SkwiezorMBAudioProcessor processor;
+            TestHelpers::setCompressing(processor);
+            setOversampling(processor, choice);
+            TestHelpers::prepare(processor, SampleRate, BlockSize);
+
+            auto buffer = programme;
+            auto nanoseconds = TestHelpers::measureNanosecondsPerSample(numSamples, 5, [&]
+            {
+                buffer.makeCopyOf(programme);
+                TestHelpers::processInBlocks(processor, buffer, BlockSize);
+            });
+
+            if ( choice == 0 )
+                hostRate = nanoseconds;
+
+            logMessage(Params::GetOversamplingChoices()[choice] + ": " + juce::String(nanoseconds, 1) + " ns ("
+                       + juce::String(nanoseconds / hostRate, 2) + "x), resamplers "
+                       + juce::String(processor.getMemoryReport().resamplers / 1024.0, 1) + " KB");
+        }
+    }
+};
+
+static OversamplingBenchmark oversamplingBenchmark;
@@ -0,0 +1,38 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 18 Oct 2026 9:12:40am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "TestHelpers.h"
+
+/**
+ Console runner for the plugin's checks and benchmarks.
+
+     SkwiezorMBTests               runs every check, exits with 1 if one fails
+     SkwiezorMBTests --benchmark   runs the benchmarks and prints their timings
+
+ Benchmarks never fail, their numbers depend on the machine. Build them in Release.
+ */
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    juce::ArgumentList arguments(argc, argv);
+
+    auto category = arguments.containsOption("--benchmark") ? TestHelpers::BenchmarkCategory : TestHelpers::CheckCategory;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory(category);
+
+    auto failures = 0;
+    for ( int i = 0; i < runner.getNumResults(); ++i )
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
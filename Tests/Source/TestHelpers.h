@@ -0,0 +1,173 @@
+/*
+  ==============================================================================
+
+    TestHelpers.h
+    Created: 18 Oct 2026 9:12:40am
+    Author:  David Werth
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../Source/PluginProcessor.h"
+
+namespace TestHelpers
+{
+inline const juce::String CheckCategory { "SkwiezorMB" };
+inline const juce::String BenchmarkCategory { "SkwiezorMB Benchmarks" };
+
+template<typename ParameterType, typename ValueType>
+void setParameter(SkwiezorMBAudioProcessor& processor, const juce::String& name, ValueType value)
+{
+    auto* parameter = dynamic_cast<ParameterType*>(processor.apvts.getParameter(name));
+    jassert( parameter != nullptr );
+
+    *parameter = value;
+}
+
+inline void setBandParameter(SkwiezorMBAudioProcessor& processor, Params::BandParam param, size_t band, float value)
+{
+    setParameter<juce::AudioParameterFloat>(processor, Params::GetBandParamName(param, band), value);
+}
+
+inline void setBandChoice(SkwiezorMBAudioProcessor& processor, Params::BandParam param, size_t band, int index)
+{
+    setParameter<juce::AudioParameterChoice>(processor, Params::GetBandParamName(param, band), index);
+}
+
+/**
+ Settings under which every band compresses part of the time: thresholds from -20 dB down,
+ fast attacks and releases, ratios from 3:1 up, and some input and output gain.
+ */
+inline void setCompressing(SkwiezorMBAudioProcessor& processor)
+{
+    using namespace Params;
+
+    for ( size_t band = 0; band < SkwiezorMBAudioProcessor::NumBands; ++band )
+    {
+        auto position = static_cast<float>(band);
+        setBandParameter(processor, BandParam::Threshold, band, -20.f - 5.f * position);
+        setBandParameter(processor, BandParam::Attack, band, 5.f / (1.f + 2.f * position));
+        setBandParameter(processor, BandParam::Release, band, 100.f / (1.f + position));
+        setBandChoice(processor, BandParam::Ratio, band, 4 + 2 * static_cast<int>(band));
+    }
+
+    setParameter<juce::AudioParameterFloat>(processor, GetParams().at(Names::Gain_In), 3.f);
+    setParameter<juce::AudioParameterFloat>(processor, GetParams().at(Names::Gain_Out), -2.f);
+}
+
+inline void prepare(SkwiezorMBAudioProcessor& processor, double sampleRate, int blockSize)
+{
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+/**
+ Noise plus a slow sine, switching between -20 dB and 0 dB every 100 ms so the compressors
+ attack and release. The channels are correlated but not identical.
+ */
+inline juce::AudioBuffer<float> makeProgramme(int numChannels, int numSamples, double sampleRate, juce::Random& random)
+{
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    auto burstLength = static_cast<int>(sampleRate / 10.0);
+
+    for ( int i = 0; i < numSamples; ++i )
+    {
+        auto level = (i / burstLength) % 2 == 0 ? 0.1f : 1.f;
+        auto common = 0.5f * std::sin(0.01f * static_cast<float>(i));
+
+        for ( int ch = 0; ch < numChannels; ++ch )
+        {
+            auto noise = 0.6f * (random.nextFloat() - 0.5f);
+            buffer.setSample(ch, i, level * (common + noise));
+        }
+    }
+
+    return buffer;
+}
+
+//a unit impulse at position on every channel
+inline juce::AudioBuffer<float> makeImpulse(int numChannels, int numSamples, int position)
+{
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    buffer.clear();
+
+    for ( int ch = 0; ch < numChannels; ++ch )
+        buffer.setSample(ch, position, 1.f);
+
+    return buffer;
+}
+
+//processes buffer in place, in blocks of blockSize (the last one may be shorter)
+template<typename SampleType>
+void processInBlocks(juce::AudioProcessor& processor, juce::AudioBuffer<SampleType>& buffer, int blockSize)
+{
+    juce::MidiBuffer midi;
+
+    for ( int start = 0; start < buffer.getNumSamples(); start += blockSize )
+    {
+        auto length = juce::jmin(blockSize, buffer.getNumSamples() - start);
+        juce::AudioBuffer<SampleType> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, length);
+        processor.processBlock(block, midi);
+    }
+}
+
+//largest |a - b| over every channel from startSample on, b delayed by delay samples against a
+inline float getMaxDifference(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b, int startSample = 0, int delay = 0)
+{
+    auto maxDifference = 0.f;
+
+    for ( int ch = 0; ch < a.getNumChannels(); ++ch )
+    {
+        for ( int i = startSample; i + delay < a.getNumSamples(); ++i )
+            maxDifference = juce::jmax(maxDifference, std::abs(a.getSample(ch, i) - b.getSample(ch, i + delay)));
+    }
+
+    return maxDifference;
+}
+
+inline float getPeak(const juce::AudioBuffer<float>& buffer, int startSample = 0)
+{
+    return buffer.getMagnitude(startSample, buffer.getNumSamples() - startSample);
+}
+
+//the lag in [0, maxDelay] at which delayed correlates best with reference
+inline int findDelay(const float* reference, const float* delayed, int numSamples, int maxDelay)
+{
+    auto bestDelay = 0;
+    auto bestCorrelation = -std::numeric_limits<double>::max();
+
+    for ( int delay = 0; delay <= maxDelay; ++delay )
+    {
+        auto correlation = 0.0;
+        for ( int i = 0; i + delay < numSamples; ++i )
+            correlation += static_cast<double>(reference[i]) * delayed[i + delay];
+
+        if ( correlation > bestCorrelation )
+        {
+            bestCorrelation = correlation;
+            bestDelay = delay;
+        }
+    }
+
+    return bestDelay;
+}
+
+//the fastest of numRuns calls of function, in nanoseconds per sample
+template<typename Function>
+double measureNanosecondsPerSample(int numSamples, int numRuns, Function&& function)
+{
+    auto best = std::numeric_limits<double>::max();
+
+    for ( int run = 0; run < numRuns; ++run )
+    {
+        auto start = juce::Time::getMillisecondCounterHiRes();
+        function();
+        best = juce::jmin(best, juce::Time::getMillisecondCounterHiRes() - start);
+    }
+
+    return best * 1.0e6 / numSamples;
+}
+}